@@ -10,48 +10,107 @@
 #include <numeric>
 #include <cstdint>
 #include <cstdio>
+#include <ctime>
+#include <new>
+#include <sys/mman.h>
 
 #include "newtonApprox.h"
 #include "lodepng.h"
+#include "tasksys.h"
 
 static constexpr int    DEF_POWER     = 3;
 static constexpr size_t DEF_WIDTH     = 10000;
 static constexpr size_t DEF_HEIGHT    = 10000;
 static constexpr unsigned short DEF_MAX_ITER = 25;
 static constexpr double DEF_MIN_STEP2 = 1e-10;
+static constexpr int    DEF_TILE_WIDTH  = 64;   // ~1k pixels per task, 8..16 gangs per tile row
+static constexpr int    DEF_TILE_HEIGHT = 16;
+static constexpr size_t NUMA_BENCH_BYTES = size_t(256) << 20;   // per node and direction
+static constexpr int64_t MAX_TILE_TASKS = int64_t(1) << 21;       // MAX_LAUNCHED_TASKS in tasksys.cpp
+
+// Tile shape the frame launch actually uses: clamped to the frame, then grown
+// (taller first, rows are cheap to add) until the tile count fits in one
+// launch. tasksys exits on launches bigger than that.
+static std::pair<int, int> fitTile(int tileWidth, int tileHeight, size_t width, size_t height) {
+    int64_t w = std::min<int64_t>(tileWidth, static_cast<int64_t>(width));
+    int64_t h = std::min<int64_t>(tileHeight, static_cast<int64_t>(height));
+    auto tiles = [&]() {
+        return ((static_cast<int64_t>(width) + w - 1) / w) * ((static_cast<int64_t>(height) + h - 1) / h);
+    };
+    while (tiles() > MAX_TILE_TASKS) {
+        if (h < static_cast<int64_t>(height)) h = std::min<int64_t>(2 * h, height);
+        else w = std::min<int64_t>(2 * w, width);
+    }
+    return {static_cast<int>(w), static_cast<int>(h)};
+}
+
+// Allocator for the per-pixel buffers. Fresh anonymous pages are already
+// zero, so resize() leaves them alone instead of zero-filling them from the
+// main thread; they're first touched by whichever task renders them, which
+// puts them on that thread's NUMA node (or the one --numa binds them to).
+template <typename T>
+struct PageAllocator {
+    using value_type = T;
+
+    PageAllocator() = default;
+    template <typename U> PageAllocator(const PageAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        if (n == 0) return nullptr;
+        void* p = mmap(nullptr, n * sizeof(T), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+    void deallocate(T* p, size_t n) {
+        if (p) munmap(p, n * sizeof(T));
+    }
+
+    // default-init on resize(), the memory is fresh from mmap and zero
+    template <typename U> void construct(U* p) { ::new (static_cast<void*>(p)) U; }
+    template <typename U, typename... Args> void construct(U* p, Args&&... args) {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U> bool operator==(const PageAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const PageAllocator<U>&) const { return false; }
+};
+
+template <typename T> using PixelVector = std::vector<T, PageAllocator<T>>;
 
 typedef struct Points 
 {
-    std::vector<double> re;
-    std::vector<double> im;
-    std::vector<short> approaches;
-    std::vector<float> convSpeed;
+    PixelVector<short> approaches;
+    PixelVector<float> convSpeed;
 
     Points(size_t width, size_t height){
-        re.resize(width*height);
-        im.resize(width*height);
         approaches.resize(width*height);
         convSpeed.resize(width*height);
     }
 } Points;
 
-typedef struct Roots{
-    std::vector<double> reRoots;
-    std::vector<double> imRoots;
-
-    Roots(short power){
-        reRoots.resize(power);
-        imRoots.resize(power);
+// With --numa the task system hands tile row ty of the frame launch to node
+// ISPCNumaNodeOf(ty, tilesY); bind the same rows of a per-pixel buffer there
+template <typename T>
+static void numaBindRows(PixelVector<T>& v, size_t width, size_t height, int tileHeight) {
+    int tilesY = static_cast<int>((height + tileHeight - 1) / tileHeight);
+    for (int ty = 0; ty < tilesY && !v.empty();) {
+        int node = ISPCNumaNodeOf(ty, tilesY);
+        int end = ty + 1;
+        while (end < tilesY && ISPCNumaNodeOf(end, tilesY) == node) ++end;
+        size_t y0 = static_cast<size_t>(ty) * tileHeight;
+        size_t y1 = std::min(static_cast<size_t>(end) * tileHeight, height);
+        ISPCNumaBind(v.data() + y0 * width, (y1 - y0) * width * sizeof(T), node);
+        ty = end;
     }
-} Roots;
+}
 
 typedef struct FrameBuff{
     size_t width;
     size_t height;
 
-    std::vector<unsigned char> red;
-    std::vector<unsigned char> green;
-    std::vector<unsigned char> blue;
+    PixelVector<unsigned char> red;
+    PixelVector<unsigned char> green;
+    PixelVector<unsigned char> blue;
 
     FrameBuff(size_t width, size_t height){
         this->width = width;
@@ -62,6 +121,7 @@ typedef struct FrameBuff{
     }
 } FrameBuff;
 
+
 //writing functions
 
 void writePPM(const FrameBuff &fb, const std::string &filename) {
@@ -115,13 +175,82 @@ Options:
   -H, --height <int>        Image height in pixels.             Default: )" << DEF_HEIGHT << R"(
   -i, --max-iter <int>      Max Newton iterations per pixel.    Default: )" << DEF_MAX_ITER << R"(
   -m, --min-step <float>    Convergence threshold (squared).    Default: )" << DEF_MIN_STEP2 << R"(
+      --precision <p>       Kernel precision: float | double | mixed | dd. Default: double
+                            mixed iterates in float and finishes lanes in double when
+                            --min-step is below float reach or z leaves float range;
+                            dd is double-double. Precisions that can't resolve the zoom
+                            level are promoted (float/mixed -> double -> dd)
+      --center <re>,<im>    View centre, decimal digits past double are kept. Default: 0,0
+      --zoom <f>            Magnification, 1 shows [-2, 2] x [-2, 2].   Default: 1
+      --generic             Always use the generic kernel (no fixed-power specialization for n = 2..16)
+      --method <m>          Root finder: newton | halley (cubic) | householder3 (quartic).
+                            Default: newton
+      --update <u>          Newton step: fused (one division) | classic. Default: fused
+      --extrapolate         Stop iterating once a pixel is deep in a root's convergence disk
+                            and predict the remaining steps (newton, halley). Shading stays
+                            within one step of the full iteration; pays off for tight --min-step
+      --analytic            Classify pixels before iterating: far-field pixels (|z^n| > 1e5) jump
+                            the steps where z only shrinks by a constant factor, pixels well inside
+                            a root's convergence disk take their counter from a lookup. Pays off
+                            on wide views (--zoom < 1)
+      --symmetry <s>        full: iterate only the wedge 0 <= arg z <= pi/n and fill the rest by
+                            rotating/mirroring root indices (nearest sample, within half a pixel),
+                            then iterate the pixels on basin boundaries of the filled frame. Still
+                            approximate: a sub-pixel feature the resampling misses stays missed;
+                            mirror: exact conjugate mirror only; off. Off-centre views drop to the
+                            mirror (centre on the real axis) or a full render. Default: off
+      --adaptive <a>        Iterate 64x64 tile borders first and fill interiors that see one root
+                            (Mariani-Silver). bounded: border counters within one step of a
+                            bilinear model, interior counters are interpolated; strict: border
+                            counters all equal; off. Ignored with --symmetry. Default: off
+      --progressive <p>     Render passes at 1/8, 1/4, 1/2 and full resolution, each iterating only
+                            the new pixels. fast: a pixel whose coarse cell corners agree on root
+                            and counter copies them; exact: iterate everything, the result is
+                            identical to a full --generic render; off. Ignored with --symmetry/--adaptive.
+                            Default: off
+      --previews            With --progressive: also write each coarse pass (NEWTON.s8.png, ...)
+      --aa <n>              Anti-alias basin boundaries: pixels whose root differs from a neighbour
+                            get n x n jittered samples (n = 2..8), the rest keep one. Default: off
+      --session <path>      Keep every pixel's z, counter and convergence in <path>. A rerun of the
+                            same view with a higher --max-iter only continues the pixels that
+                            hadn't converged. Other views or a lower --max-iter start over.
+                            Ignores --symmetry/--adaptive/--progressive and --bench
+      --boundary-only       Line art: black basin boundaries on white. Seeds from an 8 pixel grid
+                            and traces the boundaries, iterating only the pixels next to them.
+                            Boundaries that never cross the grid are missed. Overrides the
+                            other render modes and --aa. Up to 2^32 - 1 pixels
+      --cache <path>        Keep the frame (root index, counter, viewport) in <path>. The next run
+                            with the same settings copies every pixel that lands on a cached one
+                            (integer-pixel pans, zooms by powers of two) and iterates the rest.
+                            Ignores --symmetry/--adaptive/--progressive, ignored with --session
+      --palette <p>         Root colours: classic | pastel | viridis | mono, or up to 16
+                            comma separated rrggbb values. Default: classic
+      --shading <s>         Brightness over iterations: squared | linear | flat. Default: squared
+      --save-raw <path>     Also write root index and iteration count of every pixel to <path>
+      --recolor <path>      Colour a --save-raw file with --palette/--shading and write the image,
+                            no iterations (size and --max-iter come from the file, --aa is lost)
+      --tile <w>x<h>        Pixels per task of the plain kernel, one launch covers the frame with
+                            w x h tiles (a single number is a square). Tiles so small that the
+                            frame needs more than 2M of them are made taller. Default: )" << DEF_TILE_WIDTH << "x" << DEF_TILE_HEIGHT << R"(
+      --persistent          Persistent SIMD lanes: each lane pulls the next pixel as soon as it converges
+      --threads <n>         Threads rendering, this one included. Default: the CPUs we may use
+                            (affinity mask, capped by a cgroup CPU quota)
+      --affinity <a>        Pin the task threads: compact (fill hyperthreads, then cores, then
+                            sockets) | scatter (sockets first, hyperthreads last) | a CPU list
+                            like 0,2,8-15 | none. Default: none
+      --numa                Split the frame into one band of tile rows per NUMA node: the node's
+                            workers render it first and its pages are bound there. With --bench
+                            also measures per-node memory bandwidth
 
   -o, --output <path>       Output filename. Default: derived from format (NEWTON.png or NEWTON.ppm)
       --png                 Write PNG (via lodepng).            (default)
       --ppm                 Write PPM (P6, binary)
 
   # Benchmarking
-      --bench <runs>        Enable benchmarking with <runs> timed runs
+      --bench <runs>        Enable benchmarking with <runs> timed runs; also times the requested
+                            kernel with precision, method, update, extrapolation, fast path and
+                            lane scheduling flipped one at a time, without --symmetry/--adaptive/--progressive/--aa/--cache/
+                            --boundary-only, and with a few --tile shapes
       --warmup <n>          Warmup runs (not timed). Default: 1
       --no-write            Skip writing image (recommended for clean timings)
 
@@ -131,6 +260,8 @@ Examples:
   )" << prog << R"( --png -p 5 -W 800 -H 600 -i 50 -m 1e-8 -o out.png
   )" << prog << R"( --ppm --power 7 --width 4096 --height 4096
   )" << prog << R"( --bench 10 --warmup 2 --no-write -W 8000 -H 8000
+  )" << prog << R"( --precision float -W 2000 -H 2000 -o preview.png
+  )" << prog << R"( --center 0.5772156649015328606065120900824,0.1 --zoom 1e18 -W 1000 -H 1000
 )";
 }
 
@@ -153,6 +284,797 @@ static bool parseDouble(const std::string& s, double& out) {
     } catch (...) { return false; }
 }
 
+// double-double on the host, just enough to place a deep zoom viewport
+struct DD {
+    double hi = 0;
+    double lo = 0;
+};
+
+static DD ddAdd(DD a, double b) {
+    double s = a.hi + b;
+    double bb = s - a.hi;
+    double e = (a.hi - (s - bb)) + (b - bb) + a.lo;
+    double hi = s + e;
+    return {hi, e - (hi - s)};
+}
+
+static DD ddMul(DD a, double b) {
+    double p = a.hi * b;
+    double e = std::fma(a.hi, b, -p) + a.lo * b;
+    double hi = p + e;
+    return {hi, e - (hi - p)};
+}
+
+static DD ddDiv(DD a, double b) {
+    double q1 = a.hi / b;
+    DD r = ddAdd(ddMul({b, 0}, -q1), a.hi);
+    r = ddAdd(r, a.lo);
+    double q2 = r.hi / b;
+    return ddAdd({q1, 0}, q2);
+}
+
+// decimal string -> DD, keeps the ~32 digits a deep zoom centre needs
+static bool parseDD(const std::string& s, DD& out) {
+    size_t i = 0;
+    bool neg = false;
+    if (i < s.size() && (s[i] == '+' || s[i] == '-')) neg = (s[i++] == '-');
+    DD v;
+    int exp10 = 0;
+    bool digits = false, dot = false;
+    for (; i < s.size(); ++i) {
+        if (s[i] == '.' && !dot) { dot = true; continue; }
+        if (s[i] < '0' || s[i] > '9') break;
+        v = ddAdd(ddMul(v, 10.0), s[i] - '0');
+        if (dot) --exp10;
+        digits = true;
+    }
+    if (!digits) return false;
+    if (i < s.size() && (s[i] == 'e' || s[i] == 'E')) {
+        long long e;
+        if (!parseInt(s.substr(i + 1), e) || e < -400 || e > 400) return false;
+        exp10 += static_cast<int>(e);
+        i = s.size();
+    }
+    if (i != s.size()) return false;
+    for (; exp10 > 0; --exp10) v = ddMul(v, 10.0);
+    for (; exp10 < 0; ++exp10) v = ddDiv(v, 10.0);
+    out = neg ? DD{-v.hi, -v.lo} : v;
+    return true;
+}
+
+// pixel grid -> complex plane, zoom 1 is [-2, 2] x [-2, 2] around the centre
+static ispc::Viewport makeViewport(size_t width, size_t height, DD centerRe, DD centerIm, double zoom) {
+    ispc::Viewport vp;
+    DD reMin = ddAdd(centerRe, -2.0 / zoom);
+    DD imMin = ddAdd(centerIm, -2.0 / zoom);
+    vp.reMin = reMin.hi;
+    vp.reMinLo = reMin.lo;
+    vp.imMin = imMin.hi;
+    vp.imMinLo = imMin.lo;
+    vp.stepRe = 4.0 / zoom / width;
+    vp.stepIm = 4.0 / zoom / height;
+    return vp;
+}
+
+// kernel selection
+
+enum class Precision { Float, Double, Mixed, DoubleDouble };
+
+typedef decltype(&ispc::approxISPC_double) KernelFn;
+
+// kernels with the power baked in (unrolled pow and root loops),
+// index = power - MIN_FIXED_POWER
+static constexpr int MIN_FIXED_POWER = 2;
+static constexpr int MAX_FIXED_POWER = 16;
+
+static const KernelFn fixedPowerDouble[] = {
+    ispc::approxISPC_p2_double,  ispc::approxISPC_p3_double,  ispc::approxISPC_p4_double,
+    ispc::approxISPC_p5_double,  ispc::approxISPC_p6_double,  ispc::approxISPC_p7_double,
+    ispc::approxISPC_p8_double,  ispc::approxISPC_p9_double,  ispc::approxISPC_p10_double,
+    ispc::approxISPC_p11_double, ispc::approxISPC_p12_double, ispc::approxISPC_p13_double,
+    ispc::approxISPC_p14_double, ispc::approxISPC_p15_double, ispc::approxISPC_p16_double,
+};
+
+static const KernelFn fixedPowerFloat[] = {
+    ispc::approxISPC_p2_float,  ispc::approxISPC_p3_float,  ispc::approxISPC_p4_float,
+    ispc::approxISPC_p5_float,  ispc::approxISPC_p6_float,  ispc::approxISPC_p7_float,
+    ispc::approxISPC_p8_float,  ispc::approxISPC_p9_float,  ispc::approxISPC_p10_float,
+    ispc::approxISPC_p11_float, ispc::approxISPC_p12_float, ispc::approxISPC_p13_float,
+    ispc::approxISPC_p14_float, ispc::approxISPC_p15_float, ispc::approxISPC_p16_float,
+};
+
+static const KernelFn fixedPowerMixed[] = {
+    ispc::approxISPC_p2_mixed,  ispc::approxISPC_p3_mixed,  ispc::approxISPC_p4_mixed,
+    ispc::approxISPC_p5_mixed,  ispc::approxISPC_p6_mixed,  ispc::approxISPC_p7_mixed,
+    ispc::approxISPC_p8_mixed,  ispc::approxISPC_p9_mixed,  ispc::approxISPC_p10_mixed,
+    ispc::approxISPC_p11_mixed, ispc::approxISPC_p12_mixed, ispc::approxISPC_p13_mixed,
+    ispc::approxISPC_p14_mixed, ispc::approxISPC_p15_mixed, ispc::approxISPC_p16_mixed,
+};
+
+static const KernelFn fixedPowerDD[] = {
+    ispc::approxISPC_p2_dd,  ispc::approxISPC_p3_dd,  ispc::approxISPC_p4_dd,
+    ispc::approxISPC_p5_dd,  ispc::approxISPC_p6_dd,  ispc::approxISPC_p7_dd,
+    ispc::approxISPC_p8_dd,  ispc::approxISPC_p9_dd,  ispc::approxISPC_p10_dd,
+    ispc::approxISPC_p11_dd, ispc::approxISPC_p12_dd, ispc::approxISPC_p13_dd,
+    ispc::approxISPC_p14_dd, ispc::approxISPC_p15_dd, ispc::approxISPC_p16_dd,
+};
+
+static_assert(sizeof(fixedPowerDouble) / sizeof(KernelFn) == MAX_FIXED_POWER - MIN_FIXED_POWER + 1,
+              "fixed power table out of sync");
+static_assert(sizeof(fixedPowerFloat) / sizeof(KernelFn) == MAX_FIXED_POWER - MIN_FIXED_POWER + 1,
+              "fixed power table out of sync");
+static_assert(sizeof(fixedPowerMixed) / sizeof(KernelFn) == MAX_FIXED_POWER - MIN_FIXED_POWER + 1,
+              "fixed power table out of sync");
+static_assert(sizeof(fixedPowerDD) / sizeof(KernelFn) == MAX_FIXED_POWER - MIN_FIXED_POWER + 1,
+              "fixed power table out of sync");
+
+static bool hasFixedPower(int power) {
+    return power >= MIN_FIXED_POWER && power <= MAX_FIXED_POWER;
+}
+
+// specialized kernel when there is one for this power, generic one otherwise
+static KernelFn kernelFor(Precision p, int power, bool specialize) {
+    if (specialize && hasFixedPower(power)) {
+        switch (p) {
+            case Precision::Float: return fixedPowerFloat[power - MIN_FIXED_POWER];
+            case Precision::Mixed: return fixedPowerMixed[power - MIN_FIXED_POWER];
+            case Precision::DoubleDouble: return fixedPowerDD[power - MIN_FIXED_POWER];
+            default:               return fixedPowerDouble[power - MIN_FIXED_POWER];
+        }
+    }
+    switch (p) {
+        case Precision::Float: return ispc::approxISPC_float;
+        case Precision::Mixed: return ispc::approxISPC_mixed;
+        case Precision::DoubleDouble: return ispc::approxISPC_dd;
+        default:               return ispc::approxISPC_double;
+    }
+}
+
+static const char* precisionName(Precision p) {
+    switch (p) {
+        case Precision::Float: return "float";
+        case Precision::Mixed: return "mixed";
+        case Precision::DoubleDouble: return "dd";
+        default:               return "double";
+    }
+}
+
+// A pixel step has to span this many ulps of the coordinates, otherwise
+// rounding in the iteration shows up as noise long before pixels collide.
+static constexpr double RESOLVE_ULPS = 64;
+
+static bool resolves(const ispc::Viewport& vp, size_t width, size_t height, double eps) {
+    double maxAbs = std::max({std::fabs(vp.reMin), std::fabs(vp.reMin + width * vp.stepRe),
+                              std::fabs(vp.imMin), std::fabs(vp.imMin + height * vp.stepIm), 1.0});
+    return std::min(vp.stepRe, vp.stepIm) > RESOLVE_ULPS * eps * maxAbs;
+}
+
+// the requested precision, promoted until it can resolve the zoom level
+static Precision precisionFor(Precision p, const ispc::Viewport& vp, size_t width, size_t height) {
+    if ((p == Precision::Float || p == Precision::Mixed)
+        && !resolves(vp, width, height, std::numeric_limits<float>::epsilon())) {
+        p = Precision::Double;
+    }
+    if (p == Precision::Double && !resolves(vp, width, height, std::numeric_limits<double>::epsilon())) {
+        p = Precision::DoubleDouble;
+    }
+    return p;
+}
+
+// symmetric render (newtonSymmetry.isph)
+
+enum class SymmetryMode { Off, Mirror, Full };
+
+typedef decltype(&ispc::sampleWedgeISPC_double) SampleFn;
+
+static SampleFn sampleKernelFor(Precision p) {
+    switch (p) {
+        case Precision::Float: return ispc::sampleWedgeISPC_float;
+        case Precision::Mixed: return ispc::sampleWedgeISPC_mixed;
+        case Precision::DoubleDouble: return ispc::sampleWedgeISPC_dd;
+        default:               return ispc::sampleWedgeISPC_double;
+    }
+}
+
+typedef decltype(&ispc::symmetryRepairISPC_double) RepairFn;
+
+static RepairFn repairKernelFor(Precision p) {
+    switch (p) {
+        case Precision::Float: return ispc::symmetryRepairISPC_float;
+        case Precision::Mixed: return ispc::symmetryRepairISPC_mixed;
+        case Precision::DoubleDouble: return ispc::symmetryRepairISPC_dd;
+        default:               return ispc::symmetryRepairISPC_double;
+    }
+}
+
+// The n-fold rotations need the view centred on 0, the mirror only needs the
+// real axis through the middle. rotations = 0 means render every pixel.
+static ispc::Symmetry makeSymmetry(SymmetryMode mode, const ispc::Viewport& vp,
+                                   size_t width, size_t height, int power,
+                                   DD centerRe, DD centerIm) {
+    ispc::Symmetry sym = {};
+    bool onAxis = centerIm.hi == 0 && centerIm.lo == 0;
+    bool centred = onAxis && centerRe.hi == 0 && centerRe.lo == 0;
+    if (mode == SymmetryMode::Off || !onAxis) return sym;
+    sym.rotations = (mode == SymmetryMode::Full && centred && power > 1) ? power : 1;
+
+    const double pi = std::acos(-1.0);
+    double reMax = vp.reMin + width * vp.stepRe;
+    double imMax = vp.imMin + height * vp.stepIm;
+    sym.sector = 2 * pi / sym.rotations;
+    sym.cosSector = std::cos(sym.sector);
+    sym.sinSector = std::sin(sym.sector);
+    sym.cosWedge = std::cos(sym.sector / 2);
+    sym.sinWedge = std::sin(sym.sector / 2);
+    sym.margin = std::max(vp.stepRe, vp.stepIm);
+
+    // wedge extent in the plane, rotated corners can reach past the frame
+    double reLo = vp.reMin, reHi = reMax, imLo = -sym.margin, imHi = imMax;
+    sym.radius2 = std::numeric_limits<double>::max();
+    if (sym.rotations > 1) {
+        double radius = std::hypot(std::max(std::fabs(vp.reMin), std::fabs(reMax)),
+                                   std::max(std::fabs(vp.imMin), std::fabs(imMax))) + sym.margin;
+        sym.radius2 = radius * radius;
+        reLo = std::min(0.0, radius * sym.cosWedge) - sym.margin;
+        reHi = radius;
+        imHi = (sym.sector / 2 >= pi / 2 ? radius : radius * sym.sinWedge) + sym.margin;
+    }
+    sym.boxX = static_cast<int32_t>(std::floor((reLo - vp.reMin) / vp.stepRe));
+    sym.boxY = static_cast<int32_t>(std::floor((imLo - vp.imMin) / vp.stepIm));
+    sym.boxWidth = static_cast<int32_t>(std::ceil((reHi - vp.reMin) / vp.stepRe)) - sym.boxX + 1;
+    sym.boxHeight = static_cast<int32_t>(std::ceil((imHi - vp.imMin) / vp.stepIm)) - sym.boxY + 1;
+    return sym;
+}
+
+static const char* symmetryName(const ispc::Symmetry& sym) {
+    if (sym.rotations == 0) return "none";
+    return sym.rotations == 1 ? "mirror" : "mirror + rotations";
+}
+
+// adaptive render (newtonFill.isph), same values as FILL_* in newtonFill.isph
+
+enum class FillMode : uint8_t { Off = 0, Bounded = 1, Strict = 2 };
+
+typedef decltype(&ispc::adaptiveISPC_double) AdaptiveFn;
+
+static AdaptiveFn adaptiveKernelFor(Precision p) {
+    switch (p) {
+        case Precision::Float: return ispc::adaptiveISPC_float;
+        case Precision::Mixed: return ispc::adaptiveISPC_mixed;
+        case Precision::DoubleDouble: return ispc::adaptiveISPC_dd;
+        default:               return ispc::adaptiveISPC_double;
+    }
+}
+
+// progressive render (newtonProgressive.isph)
+
+enum class ProgressiveMode { Off, Fast, Exact };
+
+typedef decltype(&ispc::progressivePassISPC_double) PassFn;
+
+static PassFn passKernelFor(Precision p) {
+    switch (p) {
+        case Precision::Float: return ispc::progressivePassISPC_float;
+        case Precision::Mixed: return ispc::progressivePassISPC_mixed;
+        case Precision::DoubleDouble: return ispc::progressivePassISPC_dd;
+        default:               return ispc::progressivePassISPC_double;
+    }
+}
+
+static constexpr int PROGRESSIVE_FIRST_STRIDE = 8;   // same as in newtonProgressive.isph
+
+// NEWTON.png -> NEWTON.s8.png
+static std::string previewPath(const std::string& path, int stride) {
+    size_t dot = path.find_last_of('.');
+    size_t slash = path.find_last_of('/');
+    std::string tag = ".s" + std::to_string(stride);
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return path + tag;
+    return path.substr(0, dot) + tag + path.substr(dot);
+}
+
+// boundary anti-aliasing (newtonAA.isph)
+
+static constexpr int AA_MAX_N = 8;   // same as in newtonAA.isph
+
+typedef decltype(&ispc::antialiasISPC_double) AntialiasFn;
+
+static AntialiasFn antialiasKernelFor(Precision p) {
+    switch (p) {
+        case Precision::Float: return ispc::antialiasISPC_float;
+        case Precision::Mixed: return ispc::antialiasISPC_mixed;
+        case Precision::DoubleDouble: return ispc::antialiasISPC_dd;
+        default:               return ispc::antialiasISPC_double;
+    }
+}
+
+// render session (resumeISPC): the iteration state of every pixel of one view,
+// kept in a file between runs so a higher --max-iter only continues the pixels
+// that haven't converged
+
+typedef decltype(&ispc::resumeISPC_double) ResumeFn;
+
+static ResumeFn resumeKernelFor(Precision p) {
+    switch (p) {
+        case Precision::Float: return ispc::resumeISPC_float;
+        case Precision::Mixed: return ispc::resumeISPC_mixed;
+        case Precision::DoubleDouble: return ispc::resumeISPC_dd;
+        default:               return ispc::resumeISPC_double;
+    }
+}
+
+// same values as PIXEL_* in newtonApprox.ispc
+enum class PixelState : uint8_t { New = 0, Running = 1, Done = 2 };
+
+struct Session {
+    std::vector<double> key;   // everything but the cap that the state depends on
+    uint16_t maxIter = 0;      // cap the state was left at
+    std::vector<double> re, im;
+    std::vector<double> reLo, imLo;   // dd only
+    std::vector<uint16_t> counts;
+    std::vector<uint8_t> state;
+
+    void reset(size_t pixels, bool dd) {
+        maxIter = 0;
+        re.assign(pixels, 0);
+        im.assign(pixels, 0);
+        reLo.assign(dd ? pixels : 0, 0);
+        imLo.assign(dd ? pixels : 0, 0);
+        counts.assign(pixels, 0);
+        state.assign(pixels, static_cast<uint8_t>(PixelState::New));
+    }
+};
+
+static constexpr char SESSION_MAGIC[8] = {'N', 'E', 'W', 'T', 'S', 'E', 'S', '1'};
+
+template <typename T, typename A>
+static void writeVector(std::ofstream& out, const std::vector<T, A>& v) {
+    out.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+}
+
+template <typename T, typename A>
+static void readVector(std::ifstream& in, std::vector<T, A>& v) {
+    in.read(reinterpret_cast<char*>(v.data()), v.size() * sizeof(T));
+}
+
+// bytes from the read position to the end of the file, checked against what a
+// header promises before anything that size gets allocated
+static uint64_t bytesLeft(std::ifstream& in) {
+    std::streampos at = in.tellg();
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    in.seekg(at);
+    if (!in || at < 0 || end < at) return 0;
+    return static_cast<uint64_t>(end - at);
+}
+
+static void saveSession(const std::string& path, const Session& s) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) throw std::runtime_error("Cannot open " + path);
+    uint32_t keySize = static_cast<uint32_t>(s.key.size());
+    out.write(SESSION_MAGIC, sizeof(SESSION_MAGIC));
+    out.write(reinterpret_cast<const char*>(&keySize), sizeof(keySize));
+    writeVector(out, s.key);
+    out.write(reinterpret_cast<const char*>(&s.maxIter), sizeof(s.maxIter));
+    for (const std::vector<double>* v : {&s.re, &s.im, &s.reLo, &s.imLo}) writeVector(out, *v);
+    writeVector(out, s.counts);
+    writeVector(out, s.state);
+    if (!out) throw std::runtime_error("Write failed: " + path);
+}
+
+// Takes over the state in path when it was left by the same view (s.key) at a
+// cap no higher than maxIter. Otherwise s starts over.
+static bool loadSession(const std::string& path, Session& s, size_t pixels, bool dd, uint16_t maxIter) {
+    s.reset(pixels, dd);
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    char magic[sizeof(SESSION_MAGIC)];
+    uint32_t keySize = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&keySize), sizeof(keySize));
+    if (!in || !std::equal(magic, magic + sizeof(magic), SESSION_MAGIC) || keySize != s.key.size()) return false;
+    std::vector<double> key(keySize);
+    uint16_t savedIter = 0;
+    readVector(in, key);
+    in.read(reinterpret_cast<char*>(&savedIter), sizeof(savedIter));
+    if (!in || key != s.key || savedIter > maxIter) return false;
+
+    uint64_t bytes = s.counts.size() * sizeof(uint16_t) + s.state.size() * sizeof(uint8_t);
+    for (const std::vector<double>* v : {&s.re, &s.im, &s.reLo, &s.imLo}) bytes += v->size() * sizeof(double);
+    if (bytesLeft(in) != bytes) return false;
+    for (std::vector<double>* v : {&s.re, &s.im, &s.reLo, &s.imLo}) readVector(in, *v);
+    readVector(in, s.counts);
+    readVector(in, s.state);
+    if (!in) {
+        s.reset(pixels, dd);
+        return false;
+    }
+    s.maxIter = savedIter;
+    return true;
+}
+
+// viewport reuse (newtonReuse.isph): the last frame's root index and counter
+// per pixel, kept in a file with its viewport, so the next pan or 2x zoom only
+// iterates the pixels that frame doesn't have
+
+typedef decltype(&ispc::reuseISPC_double) ReuseFn;
+
+static ReuseFn reuseKernelFor(Precision p) {
+    switch (p) {
+        case Precision::Float: return ispc::reuseISPC_float;
+        case Precision::Mixed: return ispc::reuseISPC_mixed;
+        case Precision::DoubleDouble: return ispc::reuseISPC_dd;
+        default:               return ispc::reuseISPC_double;
+    }
+}
+
+struct FrameCache {
+    std::vector<double> key;   // everything but the viewport that the samples depend on
+    size_t width = 0;          // 0: no previous frame
+    size_t height = 0;
+    ispc::Viewport vp = {};
+    std::vector<uint32_t> samples;   // idx << 16 | counter
+};
+
+static constexpr char CACHE_MAGIC[8] = {'N', 'E', 'W', 'T', 'C', 'A', 'C', '1'};
+
+static void saveCache(const std::string& path, const FrameCache& c) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) throw std::runtime_error("Cannot open " + path);
+    uint32_t keySize = static_cast<uint32_t>(c.key.size());
+    uint64_t size[2] = {c.width, c.height};
+    out.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    out.write(reinterpret_cast<const char*>(&keySize), sizeof(keySize));
+    writeVector(out, c.key);
+    out.write(reinterpret_cast<const char*>(size), sizeof(size));
+    out.write(reinterpret_cast<const char*>(&c.vp), sizeof(c.vp));
+    writeVector(out, c.samples);
+    if (!out) throw std::runtime_error("Write failed: " + path);
+}
+
+// Takes over the frame in path when it was rendered with the same c.key.
+static bool loadCache(const std::string& path, FrameCache& c) {
+    c.width = c.height = 0;
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    char magic[sizeof(CACHE_MAGIC)];
+    uint32_t keySize = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&keySize), sizeof(keySize));
+    if (!in || !std::equal(magic, magic + sizeof(magic), CACHE_MAGIC) || keySize != c.key.size()) return false;
+    std::vector<double> key(keySize);
+    uint64_t size[2] = {0, 0};
+    readVector(in, key);
+    in.read(reinterpret_cast<char*>(size), sizeof(size));
+    in.read(reinterpret_cast<char*>(&c.vp), sizeof(c.vp));
+    if (!in || key != c.key || size[0] == 0 || size[1] == 0 || size[0] > (1u << 20) || size[1] > (1u << 20)
+        || bytesLeft(in) != size[0] * size[1] * sizeof(uint32_t)) {
+        return false;
+    }
+    c.samples.resize(size[0] * size[1]);
+    readVector(in, c.samples);
+    if (!in) return false;
+    c.width = size[0];
+    c.height = size[1];
+    return true;
+}
+
+// r when it is a power of two (within rounding), 0 otherwise
+static double powerOfTwo(double r) {
+    double p = std::exp2(std::round(std::log2(r)));
+    return std::fabs(r - p) <= 1e-9 * p ? p : 0;
+}
+
+// where the new pixel lattice sits on the cached one; steps that aren't a power
+// of two apart never line up and reuse nothing
+static ispc::ViewportReuse makeReuse(const FrameCache& c, const ispc::Viewport& vp) {
+    ispc::ViewportReuse reuse = {};
+    if (c.width == 0) return reuse;
+    reuse.ratioX = powerOfTwo(vp.stepRe / c.vp.stepRe);
+    reuse.ratioY = powerOfTwo(vp.stepIm / c.vp.stepIm);
+    if (reuse.ratioX == 0 || reuse.ratioY == 0) return reuse;
+    // origins are double-doubles, their difference is what matters
+    reuse.offsetX = ((vp.reMin - c.vp.reMin) + (vp.reMinLo - c.vp.reMinLo)) / c.vp.stepRe;
+    reuse.offsetY = ((vp.imMin - c.vp.imMin) + (vp.imMinLo - c.vp.imMinLo)) / c.vp.stepIm;
+    reuse.prevWidth = static_cast<int32_t>(c.width);
+    reuse.prevHeight = static_cast<int32_t>(c.height);
+    return reuse;
+}
+
+// boundary-only render: traces the edges between basins and iterates only the
+// pixels next to them (evaluateISPC does the iterating, a list at a time)
+
+typedef decltype(&ispc::evaluateISPC_double) EvaluateFn;
+
+static EvaluateFn evaluateKernelFor(Precision p) {
+    switch (p) {
+        case Precision::Float: return ispc::evaluateISPC_float;
+        case Precision::Mixed: return ispc::evaluateISPC_mixed;
+        case Precision::DoubleDouble: return ispc::evaluateISPC_dd;
+        default:               return ispc::evaluateISPC_double;
+    }
+}
+
+static constexpr size_t BOUNDARY_GRID = 8;   // seed grid spacing in pixels
+static constexpr short ROOT_UNKNOWN = -1;
+
+// Fills roots[] (ROOT_UNKNOWN on entry) only where needed and returns the
+// pixels on a basin boundary: every pixel whose root differs from its right or
+// lower neighbour, a one pixel line. evaluate(list) iterates a list of pixels.
+// Pixel indices are 32 bits, main() rejects frames with more pixels.
+// 1. seed grid: every BOUNDARY_GRID-th pixel of every BOUNDARY_GRID-th row/column
+// 2. grid neighbours with different roots are bisected down to two adjacent
+//    pixels, both are edge pixels (root differs from a 4-neighbour)
+// 3. breadth-first from the seeds over the 8-neighbours of edge pixels
+// Each round evaluates all its pixels in one list, so the gang stays full.
+// Work follows the boundary length; islands that never cross a grid line
+// are missed.
+template <typename Evaluate>
+static std::vector<uint32_t> traceBoundaries(size_t width, size_t height, std::vector<short>& roots,
+                                             Evaluate&& evaluate) {
+    enum : uint8_t { Queued = 1, Visited = 2 };
+    std::vector<uint8_t> mark(width * height, 0);
+    std::vector<uint32_t> need;
+    auto request = [&](size_t x, size_t y) {
+        uint32_t p = static_cast<uint32_t>(y * width + x);
+        if (!(mark[p] & Queued)) {
+            mark[p] |= Queued;
+            need.push_back(p);
+        }
+    };
+    auto flush = [&]() {
+        if (!need.empty()) evaluate(need);
+        need.clear();
+    };
+
+    std::vector<size_t> gridX, gridY;
+    for (size_t x = 0; x < width; x += BOUNDARY_GRID) gridX.push_back(x);
+    if (gridX.back() != width - 1) gridX.push_back(width - 1);
+    for (size_t y = 0; y < height; y += BOUNDARY_GRID) gridY.push_back(y);
+    if (gridY.back() != height - 1) gridY.push_back(height - 1);
+    for (size_t y : gridY) {
+        for (size_t x : gridX) request(x, y);
+    }
+    flush();
+
+    // grid segments with different roots at their ends, in pixel indices with step 1 or width
+    struct Segment { uint32_t lo, hi, step; };
+    std::vector<Segment> segments;
+    auto addSegment = [&](size_t a, size_t b, size_t step) {
+        if (roots[a] != roots[b]) {
+            segments.push_back({static_cast<uint32_t>(a), static_cast<uint32_t>(b), static_cast<uint32_t>(step)});
+        }
+    };
+    for (size_t y : gridY) {
+        for (size_t i = 1; i < gridX.size(); ++i) addSegment(y * width + gridX[i-1], y * width + gridX[i], 1);
+    }
+    for (size_t x : gridX) {
+        for (size_t i = 1; i < gridY.size(); ++i) addSegment(gridY[i-1] * width + x, gridY[i] * width + x, width);
+    }
+    for (bool open = true; open;) {
+        open = false;
+        for (const Segment& sg : segments) {
+            uint32_t n = (sg.hi - sg.lo) / sg.step;
+            if (n < 2) continue;
+            uint32_t mid = sg.lo + n / 2 * sg.step;
+            request(mid % width, mid / width);
+            open = true;
+        }
+        flush();
+        for (Segment& sg : segments) {
+            uint32_t n = (sg.hi - sg.lo) / sg.step;
+            if (n < 2) continue;
+            uint32_t mid = sg.lo + n / 2 * sg.step;
+            if (roots[mid] != roots[sg.lo]) sg.hi = mid;
+            else sg.lo = mid;
+        }
+    }
+
+    std::vector<uint32_t> frontier, next, edges;
+    for (const Segment& sg : segments) {
+        for (uint32_t p : {sg.lo, sg.hi}) {
+            if (!(mark[p] & Visited)) {
+                mark[p] |= Visited;
+                frontier.push_back(p);
+            }
+        }
+    }
+    while (!frontier.empty()) {
+        for (uint32_t p : frontier) {
+            size_t x = p % width, y = p / width;
+            request(x, y);
+            if (x > 0) request(x - 1, y);
+            if (x + 1 < width) request(x + 1, y);
+            if (y > 0) request(x, y - 1);
+            if (y + 1 < height) request(x, y + 1);
+        }
+        flush();
+
+        next.clear();
+        for (uint32_t p : frontier) {
+            size_t x = p % width, y = p / width;
+            short r = roots[p];
+            bool right = x + 1 < width && roots[p + 1] != r;
+            bool below = y + 1 < height && roots[p + width] != r;
+            bool edge = right || below || (x > 0 && roots[p - 1] != r) || (y > 0 && roots[p - width] != r);
+            if (!edge) continue;
+            if (right || below) edges.push_back(p);
+            for (size_t ny = (y > 0 ? y - 1 : y); ny <= std::min(y + 1, height - 1); ++ny) {
+                for (size_t nx = (x > 0 ? x - 1 : x); nx <= std::min(x + 1, width - 1); ++nx) {
+                    uint32_t q = static_cast<uint32_t>(ny * width + nx);
+                    if (!(mark[q] & Visited)) {
+                        mark[q] |= Visited;
+                        next.push_back(q);
+                    }
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    return edges;
+}
+
+// colouring (shadeColor/colorizeISPC in newtonApprox.ispc)
+
+// same values as SHADE_* in newtonApprox.ispc
+enum class Shading : uint8_t { Squared = 0, Linear = 1, Flat = 2 };
+
+// root colours in root order, the kernel repeats them when there are more roots
+struct Palette {
+    const char* name;
+    std::vector<uint8_t> r, g, b;
+};
+
+static const Palette PALETTES[] = {
+    {"classic", {255,   0,   0, 255, 255, 128,   0, 255},
+                {  0, 255,   0, 255, 165,   0, 255, 192},
+                {  0,   0, 255,   0,   0, 128, 255, 203}},
+    {"pastel",  {255, 255, 255, 186, 186, 218, 255, 200},
+                {179, 223, 255, 255, 225, 186, 186, 200},
+                {186, 186, 186, 201, 255, 255, 243, 200}},
+    {"viridis", { 68,  70,  54,  39,  31,  74, 159, 253},
+                {  1,  50,  92, 127, 161, 194, 218, 231},
+                { 84, 127, 141, 142, 135, 109,  58,  37}},
+    {"mono",    {255}, {255}, {255}},
+};
+
+static constexpr int PALETTE_SIZE = 16;   // same as in newtonApprox.ispc
+
+// comma separated CPU numbers and a-b ranges, e.g. 0,2,8-15
+static bool parseCpuList(const std::string& v, std::vector<int>& out) {
+    std::vector<int> cpus;
+    size_t pos = 0;
+    while (pos <= v.size()) {
+        size_t comma = std::min(v.find(',', pos), v.size());
+        std::string item = v.substr(pos, comma - pos);
+        size_t dash = item.find('-');
+        long long first = 0, last = 0;
+        bool ok = dash == std::string::npos ? parseInt(item, first)
+                                            : parseInt(item.substr(0, dash), first) && parseInt(item.substr(dash + 1), last);
+        if (dash == std::string::npos) last = first;
+        if (!ok || first < 0 || last < first || last >= 4096) return false;
+        for (long long c = first; c <= last; ++c) cpus.push_back(static_cast<int>(c));
+        pos = comma + 1;
+    }
+    out = cpus;
+    return true;
+}
+
+// a palette name or up to PALETTE_SIZE comma separated rrggbb colours
+static bool parsePalette(const std::string& v, Palette& out) {
+    for (const Palette& p : PALETTES) {
+        if (v == p.name) {
+            out = p;
+            return true;
+        }
+    }
+    Palette custom = {"custom", {}, {}, {}};
+    size_t pos = 0;
+    while (pos <= v.size()) {
+        size_t comma = std::min(v.find(',', pos), v.size());
+        std::string hex = v.substr(pos, comma - pos);
+        if (hex.size() != 6 || hex.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos) return false;
+        unsigned long rgb = std::stoul(hex, nullptr, 16);
+        custom.r.push_back(static_cast<uint8_t>(rgb >> 16));
+        custom.g.push_back(static_cast<uint8_t>(rgb >> 8));
+        custom.b.push_back(static_cast<uint8_t>(rgb));
+        pos = comma + 1;
+    }
+    if (custom.r.size() > PALETTE_SIZE) return false;
+    out = custom;
+    return true;
+}
+
+// root index and counter of every pixel (--save-raw), enough to recolour a
+// render with another palette without iterating again (--recolor)
+
+static constexpr char RAW_MAGIC[8] = {'N', 'E', 'W', 'T', 'R', 'A', 'W', '1'};
+
+static void saveRaw(const std::string& path, size_t width, size_t height, uint16_t maxIter, const Points& points) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) throw std::runtime_error("Cannot open " + path);
+    uint64_t size[2] = {width, height};
+    out.write(RAW_MAGIC, sizeof(RAW_MAGIC));
+    out.write(reinterpret_cast<const char*>(size), sizeof(size));
+    out.write(reinterpret_cast<const char*>(&maxIter), sizeof(maxIter));
+    writeVector(out, points.approaches);
+    writeVector(out, points.convSpeed);
+    if (!out) throw std::runtime_error("Write failed: " + path);
+}
+
+static Points loadRaw(const std::string& path, size_t& width, size_t& height, uint16_t& maxIter) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Cannot open " + path);
+    char magic[sizeof(RAW_MAGIC)];
+    uint64_t size[2] = {0, 0};
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(size), sizeof(size));
+    in.read(reinterpret_cast<char*>(&maxIter), sizeof(maxIter));
+    if (!in || !std::equal(magic, magic + sizeof(magic), RAW_MAGIC) || size[0] == 0 || size[1] == 0
+        || size[0] > (1u << 20) || size[1] > (1u << 20) || maxIter == 0) {
+        throw std::runtime_error("Not a raw render: " + path);
+    }
+    if (bytesLeft(in) != size[0] * size[1] * (sizeof(short) + sizeof(float))) {
+        throw std::runtime_error("Raw render doesn't match its size: " + path);
+    }
+    width = size[0];
+    height = size[1];
+    Points points(width, height);
+    readVector(in, points.approaches);
+    readVector(in, points.convSpeed);
+    if (!in) throw std::runtime_error("Truncated raw render: " + path);
+    return points;
+}
+
+// same values as METHOD_* in newtonApprox.ispc
+enum class Method : uint8_t { Newton = 0, Halley = 1, Householder3 = 2 };
+
+static const char* methodName(Method m) {
+    switch (m) {
+        case Method::Halley:       return "halley";
+        case Method::Householder3: return "householder3";
+        default:                   return "newton";
+    }
+}
+
+// everything that picks a kernel or changes what it does per iteration
+struct KernelConfig {
+    Precision precision = Precision::Double;
+    Method method = Method::Newton;
+    bool specialize = true;
+    bool fused = true;   // one division per step instead of inverse + scale + sum
+    bool extrapolate = false;   // predict the last steps inside the convergence disk
+    bool analytic = false;   // far-field jump and disk lookup before the first step
+    bool persistent = false;   // lanes refill from a per-tile queue instead of foreach gangs
+    SymmetryMode symmetry = SymmetryMode::Off;   // iterate one wedge, remap the rest
+    FillMode fill = FillMode::Off;   // fill tile interiors from their borders
+    ProgressiveMode progressive = ProgressiveMode::Off;   // coarse-to-fine passes
+    int aa = 1;   // samples per axis on basin boundaries, 1 is off
+    bool reuse = false;   // copy what the cached previous frame already has
+    bool boundary = false;   // only trace the lines between basins
+    int tileWidth = DEF_TILE_WIDTH;   // task size of the plain kernels
+    int tileHeight = DEF_TILE_HEIGHT;
+};
+
+static std::string configName(const KernelConfig& c) {
+    std::string step = methodName(c.method);
+    if (c.method == Method::Newton) step += c.fused ? "-fused" : "-classic";
+    return std::string(precisionName(c.precision)) + "/" + step
+         + (c.extrapolate ? "/extrapolated" : "")
+         + (c.analytic ? "/analytic" : "")
+         + (c.persistent ? "/persistent" : "/foreach")
+         + (c.symmetry == SymmetryMode::Full ? "/symmetric"
+            : c.symmetry == SymmetryMode::Mirror ? "/mirror" : "")
+         + (c.fill == FillMode::Bounded ? "/adaptive"
+            : c.fill == FillMode::Strict ? "/adaptive-strict" : "")
+         + (c.progressive == ProgressiveMode::Fast ? "/progressive"
+            : c.progressive == ProgressiveMode::Exact ? "/progressive-exact" : "")
+         + (c.aa > 1 ? "/aa" + std::to_string(c.aa) : "")
+         + (c.reuse ? "/reuse" : "")
+         + (c.boundary ? "/boundary" : "")
+         + (c.tileWidth != DEF_TILE_WIDTH || c.tileHeight != DEF_TILE_HEIGHT
+            ? "/tile" + std::to_string(c.tileWidth) + "x" + std::to_string(c.tileHeight) : "");
+}
+
 // benchmarking functions 
 
 struct Stats {
@@ -161,6 +1083,28 @@ struct Stats {
     double median_ms = 0;
 };
 
+// cpu_ms gets the mean process CPU time per timed run, all threads together
+template <typename F>
+static std::vector<double> time_runs(int warmup_runs, int bench_runs, F&& run, double* cpu_ms = nullptr) {
+    // Warmup
+    for (int w = 0; w < warmup_runs; ++w) run();
+
+    std::vector<double> times_ms;
+    times_ms.reserve(static_cast<size_t>(bench_runs));
+    std::clock_t cpu0 = std::clock();
+    for (int r = 0; r < bench_runs; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        run();
+        auto t1 = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::milli> dt = t1 - t0;
+        times_ms.push_back(dt.count());
+    }
+    if (cpu_ms && bench_runs > 0) {
+        *cpu_ms = 1000.0 * (std::clock() - cpu0) / CLOCKS_PER_SEC / bench_runs;
+    }
+    return times_ms;
+}
+
 static Stats compute_stats(const std::vector<double>& ms, size_t pixels) {
     Stats s;
     if (ms.empty()) return s;
@@ -184,6 +1128,9 @@ int main(int argc, char** argv) {
     size_t height = DEF_HEIGHT;
     unsigned short max_iter = DEF_MAX_ITER;
     double min_step2 = DEF_MIN_STEP2;
+    KernelConfig kcfg;
+    DD center_re, center_im;
+    double zoom = 1.0;
 
     enum class Format { PNG, PPM };
     Format fmt = Format::PNG;
@@ -194,6 +1141,17 @@ int main(int argc, char** argv) {
     int warmup_runs = 1;
     std::string csv_path;
     bool no_write = false;
+    bool previews = false;   // write the coarse progressive passes too
+    std::string session_path;
+    Palette palette = PALETTES[0];
+    Shading shading = Shading::Squared;
+    std::string raw_path;       // --save-raw
+    std::string recolor_path;   // --recolor
+    std::string cache_path;
+    int threads = 0;            // 0: whatever the task system finds
+    ISPCAffinity affinity = ISPC_AFFINITY_NONE;
+    std::vector<int> affinity_cpus;
+    bool numa = false;
 
     for (int a = 1; a < argc; ++a) {
         std::string arg = argv[a];
@@ -250,6 +1208,169 @@ int main(int argc, char** argv) {
                 return 1;
             }
             min_step2 = v;
+        } else if (arg == "--precision") {
+            if (!lastParam(arg.c_str())) return 1;
+            std::string v = argv[++a];
+            if (v == "float") kcfg.precision = Precision::Float;
+            else if (v == "double") kcfg.precision = Precision::Double;
+            else if (v == "mixed") kcfg.precision = Precision::Mixed;
+            else if (v == "dd") kcfg.precision = Precision::DoubleDouble;
+            else {
+                std::cerr << "Invalid --precision: " << v << " (expected float, double, mixed or dd)\n";
+                return 1;
+            }
+        } else if (arg == "--generic") {
+            kcfg.specialize = false;
+        } else if (arg == "--update") {
+            if (!lastParam(arg.c_str())) return 1;
+            std::string v = argv[++a];
+            if (v == "fused") kcfg.fused = true;
+            else if (v == "classic") kcfg.fused = false;
+            else {
+                std::cerr << "Invalid --update: " << v << " (expected fused or classic)\n";
+                return 1;
+            }
+        } else if (arg == "--method") {
+            if (!lastParam(arg.c_str())) return 1;
+            std::string v = argv[++a];
+            if (v == "newton") kcfg.method = Method::Newton;
+            else if (v == "halley") kcfg.method = Method::Halley;
+            else if (v == "householder3") kcfg.method = Method::Householder3;
+            else {
+                std::cerr << "Invalid --method: " << v << " (expected newton, halley or householder3)\n";
+                return 1;
+            }
+        } else if (arg == "--extrapolate") {
+            kcfg.extrapolate = true;
+        } else if (arg == "--analytic") {
+            kcfg.analytic = true;
+        } else if (arg == "--symmetry") {
+            if (!lastParam(arg.c_str())) return 1;
+            std::string v = argv[++a];
+            if (v == "full") kcfg.symmetry = SymmetryMode::Full;
+            else if (v == "mirror") kcfg.symmetry = SymmetryMode::Mirror;
+            else if (v == "off") kcfg.symmetry = SymmetryMode::Off;
+            else {
+                std::cerr << "Invalid --symmetry: " << v << " (expected full, mirror or off)\n";
+                return 1;
+            }
+        } else if (arg == "--adaptive") {
+            if (!lastParam(arg.c_str())) return 1;
+            std::string v = argv[++a];
+            if (v == "bounded") kcfg.fill = FillMode::Bounded;
+            else if (v == "strict") kcfg.fill = FillMode::Strict;
+            else if (v == "off") kcfg.fill = FillMode::Off;
+            else {
+                std::cerr << "Invalid --adaptive: " << v << " (expected bounded, strict or off)\n";
+                return 1;
+            }
+        } else if (arg == "--progressive") {
+            if (!lastParam(arg.c_str())) return 1;
+            std::string v = argv[++a];
+            if (v == "fast") kcfg.progressive = ProgressiveMode::Fast;
+            else if (v == "exact") kcfg.progressive = ProgressiveMode::Exact;
+            else if (v == "off") kcfg.progressive = ProgressiveMode::Off;
+            else {
+                std::cerr << "Invalid --progressive: " << v << " (expected fast, exact or off)\n";
+                return 1;
+            }
+        } else if (arg == "--aa") {
+            if (!lastParam(arg.c_str())) return 1;
+            long long v;
+            if (!parseInt(argv[++a], v) || v < 1 || v > AA_MAX_N) {
+                std::cerr << "Invalid --aa: " << argv[a] << " (expected 1 to " << AA_MAX_N << ")\n";
+                return 1;
+            }
+            kcfg.aa = static_cast<int>(v);
+        } else if (arg == "--previews") {
+            previews = true;
+        } else if (arg == "--session") {
+            if (!lastParam(arg.c_str())) return 1;
+            session_path = argv[++a];
+        } else if (arg == "--tile") {
+            if (!lastParam(arg.c_str())) return 1;
+            std::string v = argv[++a];
+            size_t x = v.find('x');
+            long long w = 0, h = 0;
+            bool ok = x == std::string::npos ? parseInt(v, w)
+                                             : parseInt(v.substr(0, x), w) && parseInt(v.substr(x + 1), h);
+            if (x == std::string::npos) h = w;
+            if (!ok || w < 1 || h < 1 || w > (1 << 20) || h > (1 << 20)) {
+                std::cerr << "Invalid --tile: " << v << " (expected <w>x<h> or <n>)\n";
+                return 1;
+            }
+            kcfg.tileWidth = static_cast<int>(w);
+            kcfg.tileHeight = static_cast<int>(h);
+        } else if (arg == "--threads") {
+            if (!lastParam(arg.c_str())) return 1;
+            long long v;
+            if (!parseInt(argv[++a], v) || v < 1 || v > 4096) {
+                std::cerr << "Invalid --threads: " << argv[a] << "\n";
+                return 1;
+            }
+            threads = static_cast<int>(v);
+        } else if (arg == "--affinity") {
+            if (!lastParam(arg.c_str())) return 1;
+            std::string v = argv[++a];
+            if (v == "none") affinity = ISPC_AFFINITY_NONE;
+            else if (v == "compact") affinity = ISPC_AFFINITY_COMPACT;
+            else if (v == "scatter") affinity = ISPC_AFFINITY_SCATTER;
+            else if (parseCpuList(v, affinity_cpus)) affinity = ISPC_AFFINITY_LIST;
+            else {
+                std::cerr << "Invalid --affinity: " << v << " (expected compact, scatter, none or a CPU list)\n";
+                return 1;
+            }
+        } else if (arg == "--numa") {
+            numa = true;
+        } else if (arg == "--boundary-only") {
+            kcfg.boundary = true;
+        } else if (arg == "--cache") {
+            if (!lastParam(arg.c_str())) return 1;
+            cache_path = argv[++a];
+            kcfg.reuse = true;
+        } else if (arg == "--palette") {
+            if (!lastParam(arg.c_str())) return 1;
+            std::string v = argv[++a];
+            if (!parsePalette(v, palette)) {
+                std::cerr << "Invalid --palette: " << v
+                          << " (expected classic, pastel, viridis, mono or up to 16 rrggbb,...)\n";
+                return 1;
+            }
+        } else if (arg == "--shading") {
+            if (!lastParam(arg.c_str())) return 1;
+            std::string v = argv[++a];
+            if (v == "squared") shading = Shading::Squared;
+            else if (v == "linear") shading = Shading::Linear;
+            else if (v == "flat") shading = Shading::Flat;
+            else {
+                std::cerr << "Invalid --shading: " << v << " (expected squared, linear or flat)\n";
+                return 1;
+            }
+        } else if (arg == "--save-raw") {
+            if (!lastParam(arg.c_str())) return 1;
+            raw_path = argv[++a];
+        } else if (arg == "--recolor") {
+            if (!lastParam(arg.c_str())) return 1;
+            recolor_path = argv[++a];
+        } else if (arg == "--persistent") {
+            kcfg.persistent = true;
+        } else if (arg == "--center") {
+            if (!lastParam(arg.c_str())) return 1;
+            std::string v = argv[++a];
+            size_t comma = v.find(',');
+            if (comma == std::string::npos || !parseDD(v.substr(0, comma), center_re)
+                || !parseDD(v.substr(comma + 1), center_im)) {
+                std::cerr << "Invalid --center: " << v << " (expected <re>,<im>)\n";
+                return 1;
+            }
+        } else if (arg == "--zoom") {
+            if (!lastParam(arg.c_str())) return 1;
+            double v;
+            if (!parseDouble(argv[++a], v) || !(v > 0.0) || !std::isfinite(v)) {
+                std::cerr << "Invalid --zoom: " << argv[a] << "\n";
+                return 1;
+            }
+            zoom = v;
         } else if (arg == "-o" || arg == "--output") {
             if (!lastParam(arg.c_str())) return 1;
             out_path = argv[++a];
@@ -282,42 +1403,231 @@ int main(int argc, char** argv) {
         }
     }
 
+    // traceBoundaries and evaluateISPC index pixels with 32 bits
+    if (kcfg.boundary && width * height > std::numeric_limits<uint32_t>::max()) {
+        std::cerr << "--boundary-only supports up to " << std::numeric_limits<uint32_t>::max()
+                  << " pixels, got " << width << "x" << height << "\n";
+        return 1;
+    }
+
     if (out_path.empty()) {
         out_path = (fmt == Format::PNG) ? "NEWTON.png" : "NEWTON.ppm";
     }
 
-    Points points(width, height);
-    Roots roots(static_cast<short>(power));
+    // before anything launches, the task system reads this once
+    ISPCSetTaskSystem(threads, affinity, affinity_cpus.data(), static_cast<int>(affinity_cpus.size()));
+    ISPCSetNuma(numa);
+
+    ispc::setPaletteISPC(palette.r.data(), palette.g.data(), palette.b.data(),
+                         static_cast<int32_t>(palette.r.size()), static_cast<uint8_t>(shading));
+
+    // recolour only: one pass over the stored indices and counters
+    if (!recolor_path.empty()) {
+        Points raw(0, 0);
+        try {
+            raw = loadRaw(recolor_path, width, height, max_iter);
+        } catch (const std::exception& e) {
+            std::cerr << "Recolor error: " << e.what() << "\n";
+            return 1;
+        }
+        FrameBuff buff(width, height);
+        auto recolor = [&]() {
+            ispc::colorizeISPC(width, height, raw.approaches.data(), raw.convSpeed.data(), max_iter,
+                               buff.red.data(), buff.green.data(), buff.blue.data());
+        };
+        if (bench_runs > 0) {
+            Stats s = compute_stats(time_runs(warmup_runs, bench_runs, recolor), width * height);
+            std::cout << "Recolor " << width << "x" << height << " (" << bench_runs << " runs)\n";
+            std::cout << "    min:    " << s.min_ms    << " ms\n";
+            std::cout << "    median: " << s.median_ms << " ms\n";
+        } else {
+            recolor();
+        }
+        if (no_write) return 0;
+        try {
+            if (fmt == Format::PNG) writePNG(buff, out_path);
+            else writePPM(buff, out_path);
+        } catch (const std::exception& e) {
+            std::cerr << "Write error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    ispc::Viewport vp = makeViewport(width, height, center_re, center_im, zoom);
     FrameBuff buff(width, height);
 
     const size_t pixels = width * height;
 
-    auto run_once = [&]() {
-        ispc::approxISPC(width, height,
-                         roots.reRoots.data(), roots.imRoots.data(),
-                         static_cast<unsigned short>(power),
-                         points.re.data(), points.im.data(),
-                         buff.red.data(), buff.green.data(), buff.blue.data(),
-                         max_iter, min_step2);
-    };
+    // wedge samples for the symmetric render and its filled root indices, sized on first use
+    std::vector<uint16_t> symIdx, symCount;
+    std::vector<int16_t> symRoots;
+    // packed root index/counter of the even pixels, kept between progressive passes
+    std::vector<uint32_t> passSamples;
+    bool write_previews = false;
+    // root index and counter per pixel, for anti-aliasing and --save-raw
+    bool save_raw = !raw_path.empty() && bench_runs == 0 && !kcfg.boundary;
+    bool keep_points = kcfg.aa > 1 || save_raw;
+    Points points(keep_points ? width : 0, keep_points ? height : 0);
+    if (numa) {
+        // the bands of the requested tile shape, bench variants with other tiles don't match
+        int tileHeight = fitTile(kcfg.tileWidth, kcfg.tileHeight, width, height).second;
+        numaBindRows(buff.red, width, height, tileHeight);
+        numaBindRows(buff.green, width, height, tileHeight);
+        numaBindRows(buff.blue, width, height, tileHeight);
+        numaBindRows(points.approaches, width, height, tileHeight);
+        numaBindRows(points.convSpeed, width, height, tileHeight);
+    }
+    // per-pixel state between runs, never in bench mode
+    Session session;
+    bool use_session = !session_path.empty() && bench_runs == 0 && !kcfg.boundary;
+    // previous frame and where this one sits on it, this frame's samples for the next run
+    FrameCache cache;
+    ispc::ViewportReuse reuse = {};
+    std::vector<uint32_t> frameSamples;
+    // root per pixel for the boundary trace, only filled where it looked
+    std::vector<short> boundaryRoots;
+    if (kcfg.reuse) {
+        Precision p = precisionFor(kcfg.precision, vp, width, height);
+        cache.key = {static_cast<double>(power), min_step2, static_cast<double>(max_iter),
+                     static_cast<double>(kcfg.method), static_cast<double>(kcfg.fused),
+                     static_cast<double>(p), static_cast<double>(kcfg.extrapolate),
+                     static_cast<double>(kcfg.analytic)};
+        if (loadCache(cache_path, cache)) reuse = makeReuse(cache, vp);
+    }
 
-    //benchmark mode
-    if (bench_runs > 0) {
-        // Warmup
-        for (int w = 0; w < warmup_runs; ++w) run_once();
+    auto render = [&](const KernelConfig& c, Precision p, int16_t* approaches, float* convSpeed,
+                      int64_t* laneStats) {
+        if (c.boundary) {
+            boundaryRoots.assign(pixels, ROOT_UNKNOWN);
+            size_t evaluated = 0;
+            std::vector<uint32_t> edges = traceBoundaries(width, height, boundaryRoots,
+                [&](std::vector<uint32_t>& list) {
+                    // the count is an int32, a full frame can hold more pixels than that
+                    for (size_t at = 0; at < list.size();) {
+                        size_t n = std::min(list.size() - at, static_cast<size_t>(std::numeric_limits<int32_t>::max()));
+                        evaluateKernelFor(p)(width, &vp, static_cast<unsigned short>(power),
+                                 max_iter, min_step2, static_cast<uint8_t>(c.method), c.fused, c.extrapolate, c.analytic,
+                                 list.data() + at, static_cast<int32_t>(n), boundaryRoots.data(), laneStats);
+                        at += n;
+                    }
+                    evaluated += list.size();
+                });
+            std::fill(buff.red.begin(), buff.red.end(), 255);
+            std::fill(buff.green.begin(), buff.green.end(), 255);
+            std::fill(buff.blue.begin(), buff.blue.end(), 255);
+            for (uint32_t e : edges) buff.red[e] = buff.green[e] = buff.blue[e] = 0;
+            if (laneStats) laneStats[2] += static_cast<int64_t>(pixels - evaluated);
+            return;
+        }
+        if (use_session) {
+            bool dd = p == Precision::DoubleDouble;
+            resumeKernelFor(p)(width, height, &vp, static_cast<unsigned short>(power),
+                     buff.red.data(), buff.green.data(), buff.blue.data(), approaches, convSpeed,
+                     max_iter, min_step2, static_cast<uint8_t>(c.method), c.fused, c.extrapolate, c.analytic,
+                     session.re.data(), session.im.data(),
+                     dd ? session.reLo.data() : nullptr, dd ? session.imLo.data() : nullptr,
+                     session.counts.data(), session.state.data(), laneStats);
+            return;
+        }
+        if (c.reuse) {
+            // bench variants that iterate differently can't take the cached samples
+            ispc::ViewportReuse fresh = {};
+            bool cached = c.method == kcfg.method && c.fused == kcfg.fused && c.extrapolate == kcfg.extrapolate
+                       && c.analytic == kcfg.analytic && p == precisionFor(kcfg.precision, vp, width, height);
+            frameSamples.resize(pixels);
+            reuseKernelFor(p)(width, height, &vp, static_cast<unsigned short>(power),
+                     buff.red.data(), buff.green.data(), buff.blue.data(), approaches, convSpeed,
+                     max_iter, min_step2, static_cast<uint8_t>(c.method), c.fused, c.extrapolate, c.analytic,
+                     cached ? &reuse : &fresh, cache.samples.data(), frameSamples.data(), laneStats);
+            return;
+        }
+        ispc::Symmetry sym = makeSymmetry(c.symmetry, vp, width, height, power, center_re, center_im);
+        if (sym.rotations > 0) {
+            size_t samples = static_cast<size_t>(sym.boxWidth) * sym.boxHeight;
+            if (symIdx.size() < samples) {
+                symIdx.resize(samples);
+                symCount.resize(samples);
+            }
+            sampleKernelFor(p)(&sym, &vp, static_cast<unsigned short>(power),
+                     max_iter, min_step2, static_cast<uint8_t>(c.method), c.fused, c.extrapolate, c.analytic,
+                     symIdx.data(), symCount.data(), laneStats);
+            if (sym.rotations == 1) {
+                ispc::symmetryFillISPC(width, height, &sym, &vp, static_cast<unsigned short>(power), max_iter,
+                         symIdx.data(), symCount.data(),
+                         buff.red.data(), buff.green.data(), buff.blue.data(), approaches, convSpeed);
+                return;
+            }
+            // rotated pixels are resampled, iterate the boundaries they leave
+            symRoots.resize(pixels);
+            ispc::symmetryFillISPC(width, height, &sym, &vp, static_cast<unsigned short>(power), max_iter,
+                     symIdx.data(), symCount.data(),
+                     buff.red.data(), buff.green.data(), buff.blue.data(), symRoots.data(), convSpeed);
+            if (approaches) std::copy(symRoots.begin(), symRoots.end(), approaches);
+            repairKernelFor(p)(width, height, &vp, static_cast<unsigned short>(power),
+                     buff.red.data(), buff.green.data(), buff.blue.data(), symRoots.data(), approaches, convSpeed,
+                     max_iter, min_step2, static_cast<uint8_t>(c.method), c.fused, c.extrapolate, c.analytic,
+                     laneStats);
+            return;
+        }
+        if (c.fill != FillMode::Off) {
+            adaptiveKernelFor(p)(width, height, &vp, static_cast<unsigned short>(power),
+                     buff.red.data(), buff.green.data(), buff.blue.data(), approaches, convSpeed,
+                     max_iter, min_step2, static_cast<uint8_t>(c.method), c.fused, c.extrapolate, c.analytic,
+                     static_cast<uint8_t>(c.fill), laneStats);
+            return;
+        }
 
-        std::vector<double> times_ms;
-        times_ms.reserve(static_cast<size_t>(bench_runs));
-        for (int r = 0; r < bench_runs; ++r) {
+        if (c.progressive != ProgressiveMode::Off) {
+            passSamples.resize(((width + 1) / 2) * ((height + 1) / 2));
             auto t0 = std::chrono::steady_clock::now();
-            run_once();
-            auto t1 = std::chrono::steady_clock::now();
-            std::chrono::duration<double, std::milli> dt = t1 - t0;
-            times_ms.push_back(dt.count());
+            for (int stride = PROGRESSIVE_FIRST_STRIDE; stride >= 1; stride /= 2) {
+                passKernelFor(p)(width, height, &vp, static_cast<unsigned short>(power),
+                         buff.red.data(), buff.green.data(), buff.blue.data(), approaches, convSpeed,
+                         max_iter, min_step2, static_cast<uint8_t>(c.method), c.fused, c.extrapolate, c.analytic,
+                         stride, c.progressive == ProgressiveMode::Exact, passSamples.data(), laneStats);
+                if (!write_previews || stride == 1) continue;
+
+                // blocky frame of this pass, the next pass overwrites every pixel it touches
+                std::chrono::duration<double, std::milli> dt = std::chrono::steady_clock::now() - t0;
+                ispc::progressivePreviewISPC(width, height, stride, passSamples.data(), max_iter,
+                         buff.red.data(), buff.green.data(), buff.blue.data());
+                std::string path = previewPath(out_path, stride);
+                std::cout << "1/" << stride << " pass after " << dt.count() << " ms -> " << path << "\n";
+                try {
+                    if (fmt == Format::PNG) writePNG(buff, path);
+                    else writePPM(buff, path);
+                } catch (const std::exception& e) {
+                    std::cerr << "Write error: " << e.what() << "\n";
+                }
+            }
+            return;
         }
 
-        Stats s = compute_stats(times_ms, pixels);
+        std::pair<int, int> tile = fitTile(c.tileWidth, c.tileHeight, width, height);
+        kernelFor(p, power, c.specialize)(width, height, &vp,
+                     static_cast<unsigned short>(power),
+                     buff.red.data(), buff.green.data(), buff.blue.data(), approaches, convSpeed,
+                     max_iter, min_step2, static_cast<uint8_t>(c.method), c.fused, c.extrapolate, c.analytic, c.persistent,
+                     tile.first, tile.second, laneStats);
+    };
+
+    auto run_once = [&](const KernelConfig& c, int64_t* laneStats = nullptr) {
+        Precision p = precisionFor(c.precision, vp, width, height);
+        bool keep = c.aa > 1 || save_raw;
+        int16_t* approaches = keep ? points.approaches.data() : nullptr;
+        float* convSpeed = keep ? points.convSpeed.data() : nullptr;
+        render(c, p, approaches, convSpeed, laneStats);
+        if (c.aa > 1 && !c.boundary) {
+            antialiasKernelFor(p)(width, height, &vp, static_cast<unsigned short>(power),
+                     buff.red.data(), buff.green.data(), buff.blue.data(), approaches, convSpeed,
+                     max_iter, min_step2, static_cast<uint8_t>(c.method), c.fused, c.extrapolate, c.analytic,
+                     c.aa, laneStats);
+        }
+    };
 
+    //benchmark mode
+    if (bench_runs > 0) {
         std::cout << "Benchmark results (" << bench_runs << " runs"
                   << ", warmup=" << warmup_runs << ")\n";
         std::cout << "  Size: " << width << "x" << height
@@ -325,11 +1635,138 @@ int main(int argc, char** argv) {
         std::cout << "  Power: " << power
                   << "  MaxIter: " << max_iter
                   << "  MinStep2: " << min_step2 << "\n";
-        std::cout << "  min:    " << s.min_ms    << " ms\n";
-        std::cout << "  mean:   " << s.mean_ms   << " ms\n";
-        std::cout << "  median: " << s.median_ms << " ms\n";
+        std::cout << "  Center: " << center_re.hi << "," << center_im.hi
+                  << "  Zoom: " << zoom << "\n";
+        std::cout << "  Kernel: "
+                  << ((kcfg.specialize && hasFixedPower(power)) ? "fixed power" : "generic") << "\n";
+        std::cout << "  Threads: " << (threads > 0 ? threads : ISPCAvailableCPUs())
+                  << "  Affinity: " << (affinity == ISPC_AFFINITY_COMPACT ? "compact"
+                                        : affinity == ISPC_AFFINITY_SCATTER ? "scatter"
+                                        : affinity == ISPC_AFFINITY_LIST ? "list" : "none") << "\n";
+        if (numa) {
+            // all CPUs of a node streaming through its own memory and through the next node's
+            int nodes = ISPCNumaNodes();
+            for (int k = 0; k < nodes; ++k) {
+                std::cout << "  NUMA node " << k << ": " << ISPCNumaBandwidth(k, k, NUMA_BENCH_BYTES) << " GB/s local";
+                if (nodes > 1) {
+                    int far = (k + 1) % nodes;
+                    std::cout << ", " << ISPCNumaBandwidth(k, far, NUMA_BENCH_BYTES) << " GB/s from node " << far;
+                }
+                std::cout << "\n";
+            }
+        }
+        if (kcfg.symmetry != SymmetryMode::Off) {
+            std::cout << "  Symmetry: "
+                      << symmetryName(makeSymmetry(kcfg.symmetry, vp, width, height, power, center_re, center_im))
+                      << "\n";
+        }
+
+        // the requested kernel first, then the same with one option flipped at a time
+        std::vector<KernelConfig> variants(1, kcfg);
+        KernelConfig c = kcfg;
+        for (Precision p : {Precision::Double, Precision::Float, Precision::Mixed, Precision::DoubleDouble}) {
+            if (p == kcfg.precision) continue;
+            c.precision = p;
+            variants.push_back(c);
+        }
+        c = kcfg;
+        for (Method m : {Method::Newton, Method::Halley, Method::Householder3}) {
+            if (m == kcfg.method) continue;
+            c.method = m;
+            variants.push_back(c);
+        }
+        c = kcfg;
+        if (kcfg.method == Method::Newton) {
+            c.fused = !kcfg.fused;
+            variants.push_back(c);
+            c = kcfg;
+        }
+        c.extrapolate = !kcfg.extrapolate;
+        variants.push_back(c);
+        c = kcfg;
+        c.analytic = !kcfg.analytic;
+        variants.push_back(c);
+        c = kcfg;
+        if (kcfg.symmetry != SymmetryMode::Off) {
+            c.symmetry = SymmetryMode::Off;
+            variants.push_back(c);
+            c = kcfg;
+        }
+        if (kcfg.fill != FillMode::Off) {
+            c.fill = FillMode::Off;
+            variants.push_back(c);
+            c = kcfg;
+        }
+        if (kcfg.progressive != ProgressiveMode::Off) {
+            c.progressive = ProgressiveMode::Off;
+            variants.push_back(c);
+            c = kcfg;
+        }
+        if (kcfg.aa > 1) {
+            c.aa = 1;
+            variants.push_back(c);
+            c = kcfg;
+        }
+        if (kcfg.reuse) {
+            c.reuse = false;
+            variants.push_back(c);
+            c = kcfg;
+        }
+        if (kcfg.boundary) {
+            c.boundary = false;
+            variants.push_back(c);
+            c = kcfg;
+        }
+        c.persistent = !kcfg.persistent;
+        variants.push_back(c);
+        c = kcfg;
+        // a few tile shapes, the last one is a task per row
+        for (std::pair<int, int> t : {std::make_pair(16, 16), std::make_pair(64, 16), std::make_pair(256, 8),
+                                      std::make_pair(static_cast<int>(width), 1)}) {
+            if (t.first == kcfg.tileWidth && t.second == kcfg.tileHeight) continue;
+            c.tileWidth = t.first;
+            c.tileHeight = t.second;
+            variants.push_back(c);
+        }
+
+        double base_median = 0;
+        for (const KernelConfig& v : variants) {
+            double cpu_ms = 0;
+            Stats s = compute_stats(time_runs(warmup_runs, bench_runs, [&]() { run_once(v); }, &cpu_ms), pixels);
+
+            // one extra untimed run for lane utilization
+            int64_t laneStats[4] = {0, 0, 0, 0};
+            run_once(v, laneStats);
+
+            std::cout << "  [" << configName(v) << "]";
+            Precision used = precisionFor(v.precision, vp, width, height);
+            if (used != v.precision) std::cout << " -> " << precisionName(used) << " at this zoom";
+            std::cout << "\n";
+            std::cout << "    min:    " << s.min_ms    << " ms\n";
+            std::cout << "    mean:   " << s.mean_ms   << " ms\n";
+            std::cout << "    median: " << s.median_ms << " ms\n";
+            // cores kept busy on average, threads spinning for work count too
+            std::cout << "    cpu:    " << cpu_ms << " ms/run, " << cpu_ms / s.mean_ms << " cores\n";
+            if (laneStats[1] > 0) {
+                std::cout << "    active lanes: " << 100.0 * laneStats[0] / laneStats[1] << " %\n";
+            }
+            std::cout << "    iterations/pixel: " << static_cast<double>(laneStats[0]) / pixels << "\n";
+            if (laneStats[2] > 0) {
+                std::cout << "    filled:       " << 100.0 * laneStats[2] / pixels << " % of pixels\n";
+            }
+            if (laneStats[3] > 0) {
+                std::cout << "    antialiased:  " << 100.0 * laneStats[3] / pixels << " % of pixels\n";
+            }
+            if (base_median == 0) {
+                base_median = s.median_ms;
+            } else if (s.median_ms > 0) {
+                std::cout << "    speedup of requested kernel (median): " << s.median_ms / base_median << "x\n";
+            }
+        }
 
         if (!no_write) {
+            // buffer holds whatever ran last, redo the requested kernel for the image
+            run_once(kcfg);
             try {
                 if (fmt == Format::PNG) writePNG(buff, out_path);
                 else writePPM(buff, out_path);
@@ -342,12 +1779,51 @@ int main(int argc, char** argv) {
     }
 
     //non benchmark mode
-    ispc::approxISPC(width, height,
-                      roots.reRoots.data(), roots.imRoots.data(),
-                      static_cast<unsigned short>(power),
-                      points.re.data(), points.im.data(),
-                      buff.red.data(), buff.green.data(), buff.blue.data(),
-                      max_iter, min_step2);
+    write_previews = previews && !no_write;
+    if (use_session) {
+        Precision p = precisionFor(kcfg.precision, vp, width, height);
+        session.key = {static_cast<double>(width), static_cast<double>(height), static_cast<double>(power),
+                       min_step2, static_cast<double>(kcfg.method), static_cast<double>(kcfg.fused),
+                       static_cast<double>(p), static_cast<double>(kcfg.extrapolate),
+                       static_cast<double>(kcfg.analytic), center_re.hi, center_re.lo,
+                       center_im.hi, center_im.lo, zoom};
+        if (loadSession(session_path, session, pixels, p == Precision::DoubleDouble, max_iter)) {
+            size_t done = std::count(session.state.begin(), session.state.end(),
+                                     static_cast<uint8_t>(PixelState::Done));
+            std::cout << "Resuming " << session_path << " from max-iter " << session.maxIter << ", "
+                      << 100.0 * done / pixels << " % of pixels converged\n";
+        }
+    }
+    run_once(kcfg);
+    if (save_raw) {
+        try {
+            saveRaw(raw_path, width, height, max_iter, points);
+        } catch (const std::exception& e) {
+            std::cerr << "Raw write error: " << e.what() << "\n";
+            return 1;
+        }
+    }
+    if (kcfg.reuse && !use_session && !kcfg.boundary) {
+        cache.width = width;
+        cache.height = height;
+        cache.vp = vp;
+        cache.samples.swap(frameSamples);
+        try {
+            saveCache(cache_path, cache);
+        } catch (const std::exception& e) {
+            std::cerr << "Cache error: " << e.what() << "\n";
+            return 1;
+        }
+    }
+    if (use_session) {
+        session.maxIter = max_iter;
+        try {
+            saveSession(session_path, session);
+        } catch (const std::exception& e) {
+            std::cerr << "Session error: " << e.what() << "\n";
+            return 1;
+        }
+    }
 
     try {
         if (fmt == Format::PNG) {
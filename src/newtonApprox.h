@@ -46,6 +46,48 @@ namespace ispc { /* namespace */
 #endif // defined(__clang__) || !defined(_MSC_VER)
 #endif // __ISPC_ALIGNED_STRUCT__
 
+#ifndef __ISPC_STRUCT_Viewport__
+#define __ISPC_STRUCT_Viewport__
+struct Viewport {
+    double reMin;
+    double imMin;
+    double stepRe;
+    double stepIm;
+    double reMinLo;
+    double imMinLo;
+};
+#endif
+
+#ifndef __ISPC_STRUCT_Symmetry__
+#define __ISPC_STRUCT_Symmetry__
+struct Symmetry {
+    int32_t rotations;
+    int32_t boxX;
+    int32_t boxY;
+    int32_t boxWidth;
+    int32_t boxHeight;
+    double sector;
+    double cosSector;
+    double sinSector;
+    double cosWedge;
+    double sinWedge;
+    double margin;
+    double radius2;
+};
+#endif
+
+#ifndef __ISPC_STRUCT_ViewportReuse__
+#define __ISPC_STRUCT_ViewportReuse__
+struct ViewportReuse {
+    int32_t prevWidth;
+    int32_t prevHeight;
+    double ratioX;
+    double ratioY;
+    double offsetX;
+    double offsetY;
+};
+#endif
+
 
 ///////////////////////////////////////////////////////////////////////////
 // Functions exported from ispc code
@@ -53,7 +95,106 @@ namespace ispc { /* namespace */
 #if defined(__cplusplus) && (! defined(__ISPC_NO_EXTERN_C) || !__ISPC_NO_EXTERN_C )
 extern "C" {
 #endif // __cplusplus
-    extern void approxISPC(uint32_t width, uint32_t height, double * reRoot, double * imRoot, uint16_t power, double * re, double * im, uint8_t * r, uint8_t * g, uint8_t * b, uint16_t maxIterations, double minDiff);
+    extern void approxISPC_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p2_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p3_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p4_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p5_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p6_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p7_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p8_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p9_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p10_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p11_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p12_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p13_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p14_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p15_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p16_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p2_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p3_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p4_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p5_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p6_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p7_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p8_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p9_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p10_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p11_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p12_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p13_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p14_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p15_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p16_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p2_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p3_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p4_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p5_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p6_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p7_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p8_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p9_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p10_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p11_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p12_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p13_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p14_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p15_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p16_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p2_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p3_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p4_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p5_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p6_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p7_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p8_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p9_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p10_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p11_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p12_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p13_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p14_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p15_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void approxISPC_p16_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, bool persistent, int32_t tileWidth, int32_t tileHeight, int64_t * laneStats);
+    extern void sampleWedgeISPC_double(struct Symmetry * sym, struct Viewport * vp, uint16_t power, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, uint16_t * rootIdx, uint16_t * counts, int64_t * laneStats);
+    extern void sampleWedgeISPC_float(struct Symmetry * sym, struct Viewport * vp, uint16_t power, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, uint16_t * rootIdx, uint16_t * counts, int64_t * laneStats);
+    extern void sampleWedgeISPC_mixed(struct Symmetry * sym, struct Viewport * vp, uint16_t power, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, uint16_t * rootIdx, uint16_t * counts, int64_t * laneStats);
+    extern void sampleWedgeISPC_dd(struct Symmetry * sym, struct Viewport * vp, uint16_t power, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, uint16_t * rootIdx, uint16_t * counts, int64_t * laneStats);
+    extern void symmetryRepairISPC_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * roots, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, int64_t * laneStats);
+    extern void symmetryRepairISPC_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * roots, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, int64_t * laneStats);
+    extern void symmetryRepairISPC_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * roots, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, int64_t * laneStats);
+    extern void symmetryRepairISPC_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * roots, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, int64_t * laneStats);
+    extern void adaptiveISPC_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, uint8_t fill, int64_t * laneStats);
+    extern void adaptiveISPC_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, uint8_t fill, int64_t * laneStats);
+    extern void adaptiveISPC_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, uint8_t fill, int64_t * laneStats);
+    extern void adaptiveISPC_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, uint8_t fill, int64_t * laneStats);
+    extern void evaluateISPC_double(uint32_t width, struct Viewport * vp, uint16_t power, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, uint32_t * pixels, int32_t count, int16_t * roots, int64_t * laneStats);
+    extern void evaluateISPC_float(uint32_t width, struct Viewport * vp, uint16_t power, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, uint32_t * pixels, int32_t count, int16_t * roots, int64_t * laneStats);
+    extern void evaluateISPC_mixed(uint32_t width, struct Viewport * vp, uint16_t power, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, uint32_t * pixels, int32_t count, int16_t * roots, int64_t * laneStats);
+    extern void evaluateISPC_dd(uint32_t width, struct Viewport * vp, uint16_t power, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, uint32_t * pixels, int32_t count, int16_t * roots, int64_t * laneStats);
+    extern void progressivePassISPC_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, int32_t stride, bool exact, uint32_t * samples, int64_t * laneStats);
+    extern void progressivePassISPC_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, int32_t stride, bool exact, uint32_t * samples, int64_t * laneStats);
+    extern void progressivePassISPC_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, int32_t stride, bool exact, uint32_t * samples, int64_t * laneStats);
+    extern void progressivePassISPC_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, int32_t stride, bool exact, uint32_t * samples, int64_t * laneStats);
+    extern void antialiasISPC_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, int32_t samples, int64_t * laneStats);
+    extern void antialiasISPC_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, int32_t samples, int64_t * laneStats);
+    extern void antialiasISPC_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, int32_t samples, int64_t * laneStats);
+    extern void antialiasISPC_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, int32_t samples, int64_t * laneStats);
+    extern void reuseISPC_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, struct ViewportReuse * reuse, uint32_t * prevSamples, uint32_t * samples, int64_t * laneStats);
+    extern void reuseISPC_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, struct ViewportReuse * reuse, uint32_t * prevSamples, uint32_t * samples, int64_t * laneStats);
+    extern void reuseISPC_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, struct ViewportReuse * reuse, uint32_t * prevSamples, uint32_t * samples, int64_t * laneStats);
+    extern void reuseISPC_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, struct ViewportReuse * reuse, uint32_t * prevSamples, uint32_t * samples, int64_t * laneStats);
+    extern void resumeISPC_double(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, double * zRe, double * zIm, double * zReLo, double * zImLo, uint16_t * counts, uint8_t * state, int64_t * laneStats);
+    extern void resumeISPC_float(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, double * zRe, double * zIm, double * zReLo, double * zImLo, uint16_t * counts, uint8_t * state, int64_t * laneStats);
+    extern void resumeISPC_mixed(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, double * zRe, double * zIm, double * zReLo, double * zImLo, uint16_t * counts, uint8_t * state, int64_t * laneStats);
+    extern void resumeISPC_dd(uint32_t width, uint32_t height, struct Viewport * vp, uint16_t power, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed, uint16_t maxIterations, double minDiff, uint8_t method, bool fused, bool extrapolate, bool analytic, double * zRe, double * zIm, double * zReLo, double * zImLo, uint16_t * counts, uint8_t * state, int64_t * laneStats);
+    extern void colorizeISPC(uint32_t width, uint32_t height, int16_t * approaches, float * convSpeed, uint16_t maxIterations, uint8_t * r, uint8_t * g, uint8_t * b);
+    extern void progressivePreviewISPC(uint32_t width, uint32_t height, int32_t stride, uint32_t * samples, uint16_t maxIterations, uint8_t * r, uint8_t * g, uint8_t * b);
+    extern void setPaletteISPC(uint8_t * r, uint8_t * g, uint8_t * b, int32_t count, uint8_t shade);
+    extern void symmetryFillISPC(uint32_t width, uint32_t height, struct Symmetry * sym, struct Viewport * vp, uint16_t power, uint16_t maxIterations, uint16_t * rootIdx, uint16_t * counts, uint8_t * r, uint8_t * g, uint8_t * b, int16_t * approaches, float * convSpeed);
 #if defined(__cplusplus) && (! defined(__ISPC_NO_EXTERN_C) || !__ISPC_NO_EXTERN_C )
 } /* end extern C */
 #endif // __cplusplus
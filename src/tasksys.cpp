@@ -88,15 +88,17 @@ using namespace Concurrency;
 #endif // ISPC_USE_GCD
 #ifdef ISPC_USE_PTHREADS
 #include <algorithm>
+#include <atomic>
 #include <errno.h>
-#include <fcntl.h>
 #include <pthread.h>
-#include <semaphore.h>
 #include <sys/param.h>
-#include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include <vector>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif // __linux__
 #endif // ISPC_USE_PTHREADS
 #ifdef ISPC_USE_PTHREADS_FULLY_SUBSCRIBED
 #include <algorithm>
@@ -128,6 +130,14 @@ using namespace Concurrency;
 #ifdef ISPC_IS_LINUX
 #include <stdlib.h>
 #endif // ISPC_IS_LINUX
+#if defined(ISPC_USE_PTHREADS) || defined(ISPC_USE_PTHREADS_FULLY_SUBSCRIBED)
+#include <sys/mman.h>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#endif // __linux__
+#endif
 
 #include <algorithm>
 #include <assert.h>
@@ -135,11 +145,19 @@ using namespace Concurrency;
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <chrono>
+#include <thread>
+
+#include "tasksys.h"
 
 // Signature of ispc-generated 'task' functions
 typedef void (*TaskFuncType)(void *data, int threadIndex, int threadCount, int taskIndex, int taskCount, int taskIndex0,
                              int taskIndex1, int taskIndex2, int taskCount0, int taskCount1, int taskCount2);
 
+#if defined(ISPC_USE_PTHREADS)
+class TaskGroup;
+#endif
+
 // Small structure used to hold the data for each task
 struct TaskInfo {
     TaskFuncType func;
@@ -148,6 +166,9 @@ struct TaskInfo {
     int taskCount3d[3];
 #if defined(ISPC_USE_CONCRT)
     event taskEvent;
+#endif
+#if defined(ISPC_USE_PTHREADS)
+    TaskGroup *group; // set by Launch, the deques only hold the TaskInfo
 #endif
     int taskCount() const { return taskCount3d[0] * taskCount3d[1] * taskCount3d[2]; }
     int taskIndex0() const { return taskIndex % taskCount3d[0]; }
@@ -363,33 +384,24 @@ class TaskGroup : public TaskGroupBase {
 #endif // ISPC_USE_GCD
 
 #ifdef ISPC_USE_PTHREADS
-static void *lTaskEntry(void *arg);
+static void lRunTask(TaskInfo *myTask);
 
 class TaskGroup : public TaskGroupBase {
   public:
-    TaskGroup() {
-        numUnfinishedTasks = 0;
-        waitingTasks.reserve(128);
-        inActiveList = false;
-    }
+    TaskGroup() : numUnfinishedTasks(0) {}
 
     void Reset() {
         TaskGroupBase::Reset();
         numUnfinishedTasks = 0;
-        assert(inActiveList == false);
-        lMemFence();
     }
 
     void Launch(int baseIndex, int count);
     void Sync();
 
   private:
-    friend void *lTaskEntry(void *arg);
+    friend void lRunTask(TaskInfo *myTask);
 
-    int32_t numUnfinishedTasks;
-    int32_t pad[3];
-    std::vector<int> waitingTasks;
-    bool inActiveList;
+    std::atomic<int32_t> numUnfinishedTasks;
 };
 
 #endif // ISPC_USE_PTHREADS
@@ -534,90 +546,619 @@ inline void TaskGroup::Sync() {
 
 #endif // ISPC_USE_CONCRT
 
+///////////////////////////////////////////////////////////////////////////
+// Thread count and placement, see tasksys.h
+
+#if defined(ISPC_USE_PTHREADS) || defined(ISPC_USE_PTHREADS_FULLY_SUBSCRIBED)
+
+static bool lTaskSystemStarted = false; // set by the first InitTaskSystem
+static int lConfigThreads = 0;
+static ISPCAffinity lConfigAffinity = ISPC_AFFINITY_NONE;
+static std::vector<int> lConfigCPUs;
+static bool lConfigNuma = false;
+
+bool ISPCSetTaskSystem(int threads, ISPCAffinity affinity, const int *cpus, int cpuCount) {
+    if (lTaskSystemStarted || (affinity == ISPC_AFFINITY_LIST && (cpus == nullptr || cpuCount <= 0)))
+        return false;
+    lConfigThreads = threads;
+    lConfigAffinity = affinity;
+    if (affinity == ISPC_AFFINITY_LIST)
+        lConfigCPUs.assign(cpus, cpus + cpuCount);
+    else
+        lConfigCPUs.clear();
+    return true;
+}
+
+// first number in a sysfs/cgroupfs file, -1 when it isn't there
+static long long lReadNumber(const char *path) {
+    long long v = -1;
+    FILE *f = fopen(path, "r");
+    if (f != nullptr) {
+        if (fscanf(f, "%lld", &v) != 1)
+            v = -1;
+        fclose(f);
+    }
+    return v;
+}
+
+// the CPUs in our affinity mask, which is what cpusets and taskset restrict
+static std::vector<int> lAllowedCPUs() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int i = 0; i < CPU_SETSIZE; ++i)
+            if (CPU_ISSET(i, &set))
+                cpus.push_back(i);
+    }
+#endif // __linux__
+    if (cpus.empty()) {
+        for (int i = 0; i < sysconf(_SC_NPROCESSORS_ONLN); ++i)
+            cpus.push_back(i);
+    }
+    return cpus;
+}
+
+// CPUs worth of cgroup CPU quota, 0 when there's none. Inside a container
+// the cgroup namespace puts our own group at /sys/fs/cgroup.
+static int lQuotaCPUs() {
+#ifdef __linux__
+    long long quota = -1;
+    long long period = 0;
+    FILE *f = fopen("/sys/fs/cgroup/cpu.max", "r"); // v2: "max <period>" or "<quota> <period>"
+    if (f != nullptr) {
+        char q[32];
+        if (fscanf(f, "%31s %lld", q, &period) == 2 && strcmp(q, "max") != 0)
+            quota = atoll(q);
+        fclose(f);
+    } else {
+        // v1, quota is -1 when unlimited
+        quota = lReadNumber("/sys/fs/cgroup/cpu/cpu.cfs_quota_us");
+        period = lReadNumber("/sys/fs/cgroup/cpu/cpu.cfs_period_us");
+    }
+    if (quota > 0 && period > 0)
+        return (int)((quota + period - 1) / period);
+#endif // __linux__
+    return 0;
+}
+
+int ISPCAvailableCPUs() {
+    int n = (int)lAllowedCPUs().size();
+    int quota = lQuotaCPUs();
+    if (quota > 0 && quota < n)
+        n = quota;
+    return std::max(n, 1);
+}
+
+// threads running tasks, the calling one included
+static int lThreadCount() { return lConfigThreads > 0 ? lConfigThreads : ISPCAvailableCPUs(); }
+
+static int lTopology(int cpu, const char *name) {
+    char path[128];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, name);
+    return (int)lReadNumber(path);
+}
+
+// The CPUs threads get placed on, in order; empty when they float. Without
+// sysfs topology every CPU looks like its own core on one socket and both
+// orders are just the CPU numbers.
+static std::vector<int> lPlacement() {
+    if (lConfigAffinity == ISPC_AFFINITY_NONE)
+        return std::vector<int>();
+    if (lConfigAffinity == ISPC_AFFINITY_LIST)
+        return lConfigCPUs;
+
+    struct Place {
+        int cpu;
+        int package;
+        int core;
+        int smt;      // hyperthread number within the core
+        int coreRank; // core number within the package
+    };
+    std::vector<Place> places;
+    for (int cpu : lAllowedCPUs()) {
+        int core = lTopology(cpu, "core_id");
+        places.push_back({cpu, lTopology(cpu, "physical_package_id"), core < 0 ? cpu : core, 0, 0});
+    }
+    for (Place &p : places) {
+        std::vector<int> cores;
+        for (const Place &q : places) {
+            if (q.package != p.package)
+                continue;
+            if (q.core == p.core && q.cpu < p.cpu)
+                ++p.smt;
+            if (q.core < p.core && std::find(cores.begin(), cores.end(), q.core) == cores.end())
+                cores.push_back(q.core);
+        }
+        p.coreRank = (int)cores.size();
+    }
+
+    std::stable_sort(places.begin(), places.end(), [](const Place &a, const Place &b) {
+        if (lConfigAffinity == ISPC_AFFINITY_COMPACT) {
+            if (a.package != b.package)
+                return a.package < b.package;
+            return a.coreRank != b.coreRank ? a.coreRank < b.coreRank : a.smt < b.smt;
+        }
+        if (a.smt != b.smt)
+            return a.smt < b.smt;
+        return a.coreRank != b.coreRank ? a.coreRank < b.coreRank : a.package < b.package;
+    });
+    std::vector<int> order;
+    for (const Place &p : places)
+        order.push_back(p.cpu);
+    return order;
+}
+
+// Threads created with attr run on one of cpus
+static void lPinThreadSet(pthread_attr_t *attr, const std::vector<int> &cpus) {
+#ifdef __linux__
+    if (cpus.empty())
+        return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus)
+        CPU_SET(cpu, &set);
+    int err = pthread_attr_setaffinity_np(attr, sizeof(set), &set);
+    if (err != 0)
+        fprintf(stderr, "Error setting affinity to CPU %d...: %s\n", cpus[0], strerror(err));
+#endif // __linux__
+}
+
+// Threads created with attr go to the slot-th CPU of order
+static void lPinThread(pthread_attr_t *attr, const std::vector<int> &order, int slot) {
+    if (!order.empty())
+        lPinThreadSet(attr, std::vector<int>(1, order[slot % order.size()]));
+}
+
+// NUMA nodes that have CPUs we may use. Nodes are numbered densely here,
+// ids holds the kernel's node numbers. Without sysfs it's one node.
+struct NumaTopology {
+    std::vector<int> ids;
+    std::vector<std::vector<int>> cpus;
+};
+
+// "0-3,8,10-11" as in sysfs cpulist/online files
+static std::vector<int> lParseList(const char *path) {
+    std::vector<int> list;
+    FILE *f = fopen(path, "r");
+    if (f == nullptr)
+        return list;
+    int first, last;
+    char sep = ',';
+    while (sep == ',' && fscanf(f, "%d", &first) == 1) {
+        last = first;
+        if (fscanf(f, "%c", &sep) == 1 && sep == '-') {
+            if (fscanf(f, "%d", &last) != 1)
+                break;
+            if (fscanf(f, "%c", &sep) != 1)
+                sep = '\n';
+        }
+        for (int i = first; i <= last; ++i)
+            list.push_back(i);
+    }
+    fclose(f);
+    return list;
+}
+
+static const NumaTopology &lNumaTopology() {
+    static const NumaTopology topology = [] {
+        NumaTopology t;
+        std::vector<int> allowed = lAllowedCPUs();
+        for (int id : lParseList("/sys/devices/system/node/online")) {
+            char path[128];
+            snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", id);
+            std::vector<int> cpus;
+            for (int cpu : lParseList(path))
+                if (std::find(allowed.begin(), allowed.end(), cpu) != allowed.end())
+                    cpus.push_back(cpu);
+            if (!cpus.empty()) {
+                t.ids.push_back(id);
+                t.cpus.push_back(cpus);
+            }
+        }
+        if (t.ids.empty()) {
+            t.ids.push_back(0);
+            t.cpus.push_back(allowed);
+        }
+        return t;
+    }();
+    return topology;
+}
+
+static int lNodeOfCPU(int cpu) {
+    const NumaTopology &t = lNumaTopology();
+    for (size_t k = 0; k < t.cpus.size(); ++k)
+        if (std::find(t.cpus[k].begin(), t.cpus[k].end(), cpu) != t.cpus[k].end())
+            return (int)k;
+    return 0;
+}
+
+bool ISPCSetNuma(bool on) {
+    if (lTaskSystemStarted)
+        return false;
+    lConfigNuma = on;
+    return true;
+}
+
+int ISPCNumaNodes() { return (int)lNumaTopology().ids.size(); }
+
+// nodes the rows of a 2D launch are spread over
+static int lTileNodes() { return lConfigNuma ? ISPCNumaNodes() : 1; }
+
+int ISPCNumaNodeOf(int index, int count) { return count > 0 ? (int)((int64_t)index * lTileNodes() / count) : 0; }
+
+bool ISPCNumaBind(void *addr, size_t bytes, int node) {
+#ifdef __linux__
+    const NumaTopology &t = lNumaTopology();
+    if (node < 0 || node >= (int)t.ids.size() || bytes == 0)
+        return false;
+    // The pages at either end may be shared with a neighbouring band, the
+    // later call wins.
+    uintptr_t page = sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)addr & ~(page - 1);
+    size_t len = (uintptr_t)addr + bytes - start;
+    constexpr int bits = 8 * sizeof(unsigned long);
+    unsigned long mask[1024 / bits] = {};
+    if (t.ids[node] >= 1024)
+        return false;
+    mask[t.ids[node] / bits] |= 1UL << (t.ids[node] % bits);
+    // preferred rather than bind, a full node spills over instead of failing
+    return syscall(SYS_mbind, start, len, MPOL_PREFERRED, mask, (unsigned long)1024, 0) == 0;
+#else
+    return false;
+#endif // __linux__
+}
+
+struct BandwidthSlice {
+    uint64_t *data;
+    size_t words;
+    pthread_barrier_t *start;
+};
+
+#define BANDWIDTH_PASSES 3
+
+static void *lBandwidthThread(void *arg) {
+    BandwidthSlice *s = (BandwidthSlice *)arg;
+    for (size_t i = 0; i < s->words; ++i) // fault the pages in, untimed
+        s->data[i] = i;
+    pthread_barrier_wait(s->start);
+    for (int pass = 0; pass < BANDWIDTH_PASSES; ++pass) {
+        volatile uint64_t *p = s->data;
+        for (size_t i = 0; i < s->words; ++i)
+            p[i] = p[i] + 1;
+    }
+    return nullptr;
+}
+
+double ISPCNumaBandwidth(int cpuNode, int memNode, size_t bytes) {
+    const NumaTopology &t = lNumaTopology();
+    if (cpuNode < 0 || cpuNode >= (int)t.ids.size() || memNode < 0 || memNode >= (int)t.ids.size())
+        return 0;
+    const std::vector<int> &cpus = t.cpus[cpuNode];
+    int n = (int)cpus.size();
+    size_t words = bytes / sizeof(uint64_t) / n;
+    uint64_t *data = (uint64_t *)mmap(nullptr, words * n * sizeof(uint64_t), PROT_READ | PROT_WRITE,
+                                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED)
+        return 0;
+    ISPCNumaBind(data, words * n * sizeof(uint64_t), memNode);
+
+    pthread_barrier_t start;
+    pthread_barrier_init(&start, nullptr, n + 1);
+    std::vector<pthread_t> threads(n);
+    std::vector<BandwidthSlice> slices(n);
+    for (int i = 0; i < n; ++i) {
+        slices[i] = {data + i * words, words, &start};
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        lPinThread(&attr, cpus, i);
+        pthread_create(&threads[i], &attr, &lBandwidthThread, &slices[i]);
+        pthread_attr_destroy(&attr);
+    }
+    pthread_barrier_wait(&start);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+        pthread_join(threads[i], nullptr);
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+    pthread_barrier_destroy(&start);
+    munmap(data, words * n * sizeof(uint64_t));
+    // every pass reads and writes each word
+    return 2.0 * BANDWIDTH_PASSES * words * n * sizeof(uint64_t) / dt.count() / 1e9;
+}
+
+#else
+
+// Task systems with their own runtime decide for themselves
+bool ISPCSetTaskSystem(int, ISPCAffinity, const int *, int) { return false; }
+bool ISPCSetNuma(bool) { return false; }
+
+int ISPCAvailableCPUs() { return std::max((int)std::thread::hardware_concurrency(), 1); }
+int ISPCNumaNodes() { return 1; }
+int ISPCNumaNodeOf(int, int) { return 0; }
+bool ISPCNumaBind(void *, size_t, int) { return false; }
+double ISPCNumaBandwidth(int, int, size_t) { return 0; }
+
+#endif // ISPC_USE_PTHREADS || ISPC_USE_PTHREADS_FULLY_SUBSCRIBED
+
 ///////////////////////////////////////////////////////////////////////////
 // pthreads
 
 #ifdef ISPC_USE_PTHREADS
 
+/* Work stealing. Every worker owns a Chase-Lev deque (Chase & Lev 2005, with
+   the C11 orderings of Le et al. 2013): launches push onto the launching
+   thread's deque, its owner pops from the bottom and idle threads steal from
+   the top of a randomly picked victim, so finding a task never takes a lock.
+   Threads that aren't workers (whoever calls into ispc) share one extra deque
+   at index nThreads. Only its owner side is serialized by a mutex, stealing
+   from it is the same CAS as everywhere else.
+   With NUMA tiles on (ISPCSetNuma) every node gets one more deque after
+   that. 2D launches push each band of rows onto the deque of the node it
+   belongs to (ISPCNumaNodeOf), and that node's workers steal from there
+   before they try anyone else.
+ */
+
+#define WORK_DEQUE_INITIAL_SIZE 1024
+
+struct TaskRing {
+    explicit TaskRing(int64_t size) : mask(size - 1), slots(new std::atomic<TaskInfo *>[size]) {}
+    ~TaskRing() { delete[] slots; }
+
+    TaskInfo *Get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+    void Put(int64_t i, TaskInfo *ti) { slots[i & mask].store(ti, std::memory_order_relaxed); }
+
+    int64_t mask;
+    std::atomic<TaskInfo *> *slots;
+};
+
+class alignas(64) WorkDeque {
+  public:
+    WorkDeque() : top(0), bottom(0), ring(new TaskRing(WORK_DEQUE_INITIAL_SIZE)) {}
+
+    // owner only
+    void Push(TaskInfo *ti);
+    TaskInfo *Take();
+    // any thread; lost is set when another thread won the race for the top task
+    TaskInfo *Steal(bool &lost);
+
+  private:
+    std::atomic<int64_t> top;
+    char pad[64 - sizeof(std::atomic<int64_t>)]; // thieves hammer top, the owner bottom
+    std::atomic<int64_t> bottom;
+    std::atomic<TaskRing *> ring;
+    // A thief may still be reading a ring that Push just replaced, so old
+    // rings are kept around rather than freed.
+    std::vector<TaskRing *> retired;
+};
+
+inline void WorkDeque::Push(TaskInfo *ti) {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    TaskRing *r = ring.load(std::memory_order_relaxed);
+    if (b - t > r->mask) {
+        TaskRing *grown = new TaskRing(2 * (r->mask + 1));
+        for (int64_t i = t; i < b; ++i)
+            grown->Put(i, r->Get(i));
+        retired.push_back(r);
+        ring.store(grown, std::memory_order_release);
+        r = grown;
+    }
+    r->Put(b, ti);
+    bottom.store(b + 1, std::memory_order_release); // publishes the TaskInfo to Steal
+}
+
+inline TaskInfo *WorkDeque::Take() {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    TaskRing *r = ring.load(std::memory_order_relaxed);
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+    if (t > b) {
+        // empty
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    TaskInfo *ti = r->Get(b);
+    if (t == b) {
+        // Last task, the thieves may be after it as well
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            ti = nullptr;
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return ti;
+}
+
+inline TaskInfo *WorkDeque::Steal(bool &lost) {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b)
+        return nullptr;
+
+    TaskInfo *ti = ring.load(std::memory_order_acquire)->Get(t);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        lost = true;
+        return nullptr;
+    }
+    return ti;
+}
+
 static volatile int32_t lock = 0;
 
 static int nThreads;
 static pthread_t *threads = nullptr;
 
-static pthread_mutex_t taskSysMutex;
-static std::vector<TaskGroup *> activeTaskGroups;
-static sem_t *workerSemaphore;
+static WorkDeque *deques;              // one per worker, the shared one, one per node
+static pthread_mutex_t sharedDequeMutex; // owner side of deques[nThreads]
+static int nNodeDeques;                // 0 unless NUMA tiles are on
+static pthread_mutex_t *nodeDequeMutex; // owner side of the node deques
+static int *workerNode;
+
+/* Idle workers sleep on wakeEpoch. A worker that found nothing reads the
+   epoch, counts itself in workersSleeping and only then looks at the deques
+   one last time; Launch pushes, then checks workersSleeping and if anyone
+   is (about to be) asleep bumps the epoch and wakes as many as it has tasks
+   for. Either the worker's last look sees the new tasks or Launch sees the
+   worker, and a worker that goes to sleep after the bump finds the epoch
+   changed and returns at once.
+ */
+static std::atomic<uint32_t> wakeEpoch(0);
+static std::atomic<int32_t> workersSleeping(0);
 
-static void *lTaskEntry(void *arg) {
-    int threadIndex = (int)((int64_t)arg);
-    int threadCount = nThreads;
+#ifdef __linux__
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word");
+
+static inline void lWaitEpoch(uint32_t epoch) {
+    // EAGAIN (epoch already moved on) and EINTR both just mean look again
+    syscall(SYS_futex, (uint32_t *)&wakeEpoch, FUTEX_WAIT_PRIVATE, epoch, nullptr, nullptr, 0);
+}
+
+static inline void lWakeWorkers(int count) {
+    ++wakeEpoch;
+    syscall(SYS_futex, (uint32_t *)&wakeEpoch, FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+#else
+// No futex, the same protocol on a condition variable. Wakes everybody.
+static pthread_mutex_t wakeMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wakeCond = PTHREAD_COND_INITIALIZER;
+
+static inline void lWaitEpoch(uint32_t epoch) {
+    pthread_mutex_lock(&wakeMutex);
+    while (wakeEpoch.load() == epoch)
+        pthread_cond_wait(&wakeCond, &wakeMutex);
+    pthread_mutex_unlock(&wakeMutex);
+}
+
+static inline void lWakeWorkers(int) {
+    ++wakeEpoch;
+    pthread_mutex_lock(&wakeMutex);
+    pthread_cond_broadcast(&wakeCond);
+    pthread_mutex_unlock(&wakeMutex);
+}
+#endif // __linux__
+
+/* Sync sleeps here once there's nothing left to steal. The mutex and
+   condition are shared by all groups: a group may be deleted as soon as its
+   Sync returns, while the thread that finished its last task could still be
+   about to signal. syncSleepers lets that thread skip the mutex when nobody
+   is waiting, both sides go through seq_cst atomics so either the sleeper
+   sees the count at zero or the finisher sees the sleeper.
+ */
+static pthread_mutex_t syncMutex;
+static pthread_cond_t syncCond;
+static std::atomic<int32_t> syncSleepers(0);
+
+static thread_local int lWorkerIndex = -1;
+static thread_local int lWorkerNode = -1;
+static thread_local uint32_t lStealSeed = 0;
+
+static inline int lOwnDeque() { return lWorkerIndex >= 0 ? lWorkerIndex : nThreads; }
+
+static inline void lLockSharedDeque() {
+    int err;
+    if ((err = pthread_mutex_lock(&sharedDequeMutex)) != 0) {
+        fprintf(stderr, "Error from pthread_mutex_lock: %s\n", strerror(err));
+        exit(1);
+    }
+}
+
+static inline void lUnlockSharedDeque() {
+    int err;
+    if ((err = pthread_mutex_unlock(&sharedDequeMutex)) != 0) {
+        fprintf(stderr, "Error from pthread_mutex_unlock: %s\n", strerror(err));
+        exit(1);
+    }
+}
+
+// xorshift, only has to spread the thieves over the victims
+static inline uint32_t lNextVictim() {
+    if (lStealSeed == 0)
+        lStealSeed = (uint32_t)(intptr_t)&lStealSeed | 1;
+    lStealSeed ^= lStealSeed << 13;
+    lStealSeed ^= lStealSeed >> 17;
+    lStealSeed ^= lStealSeed << 5;
+    return lStealSeed;
+}
 
+// Pop from our own deque, otherwise steal. nullptr when every deque looked
+// empty on a full sweep that didn't lose any race.
+static TaskInfo *lFindTask() {
+    int self = lOwnDeque();
+    TaskInfo *ti;
+    if (self == nThreads) {
+        lLockSharedDeque();
+        ti = deques[self].Take();
+        lUnlockSharedDeque();
+    } else
+        ti = deques[self].Take();
+    if (ti != nullptr)
+        return ti;
+
+    if (lWorkerNode >= 0 && nNodeDeques > 0) {
+        bool lost;
+        do {
+            lost = false;
+            if ((ti = deques[nThreads + 1 + lWorkerNode].Steal(lost)) != nullptr)
+                return ti;
+        } while (lost);
+    }
+
+    int nDeques = nThreads + 1 + nNodeDeques;
     while (1) {
-        int err;
-        //
-        // Wait on the semaphore until we're woken up due to the arrival of
-        // more work.
-        //
-        if ((err = sem_wait(workerSemaphore)) != 0) {
-            fprintf(stderr, "Error from sem_wait: %s\n", strerror(err));
-            exit(1);
+        bool lost = false;
+        int start = lNextVictim() % nDeques;
+        for (int i = 0; i < nDeques; ++i) {
+            int victim = (start + i) % nDeques;
+            if (victim != self && (ti = deques[victim].Steal(lost)) != nullptr)
+                return ti;
         }
+        if (!lost)
+            return nullptr;
+    }
+}
 
-        //
-        // Acquire the mutex
-        //
-        if ((err = pthread_mutex_lock(&taskSysMutex)) != 0) {
-            fprintf(stderr, "Error from pthread_mutex_lock: %s\n", strerror(err));
-            exit(1);
-        }
+static inline void lRunTask(TaskInfo *myTask) {
+    // External threads all report index nThreads, same as their deque
+    myTask->func(myTask->data, lOwnDeque(), nThreads + 1, myTask->taskIndex, myTask->taskCount(),
+                 myTask->taskIndex0(), myTask->taskIndex1(), myTask->taskIndex2(), myTask->taskCount0(),
+                 myTask->taskCount1(), myTask->taskCount2());
 
-        if (activeTaskGroups.size() == 0) {
-            //
-            // Task queue is empty, go back and wait on the semaphore
-            //
-            if ((err = pthread_mutex_unlock(&taskSysMutex)) != 0) {
-                fprintf(stderr, "Error from pthread_mutex_unlock: %s\n", strerror(err));
-                exit(1);
-            }
-            continue;
-        }
+    //
+    // Decrement the "number of unfinished tasks" counter in the task
+    // group, the last task wakes up whoever is waiting in Sync. The group
+    // must not be touched after the decrement.
+    //
+    if (myTask->group->numUnfinishedTasks.fetch_sub(1) == 1 && syncSleepers.load() > 0) {
+        pthread_mutex_lock(&syncMutex);
+        pthread_cond_broadcast(&syncCond);
+        pthread_mutex_unlock(&syncMutex);
+    }
+}
 
-        //
-        // Get the last task group on the active list and the last task
-        // from its waiting tasks list.
-        //
-        TaskGroup *tg = activeTaskGroups.back();
-        assert(tg->waitingTasks.size() > 0);
-        int taskNumber = tg->waitingTasks.back();
-        tg->waitingTasks.pop_back();
-
-        if (tg->waitingTasks.size() == 0) {
-            // We just took the last task from this task group, so remove
-            // it from the active list.
-            activeTaskGroups.pop_back();
-            tg->inActiveList = false;
-        }
+static void *lTaskEntry(void *arg) {
+    lWorkerIndex = (int)((int64_t)arg);
+    lWorkerNode = nNodeDeques > 0 ? workerNode[lWorkerIndex] : -1;
 
-        if ((err = pthread_mutex_unlock(&taskSysMutex)) != 0) {
-            fprintf(stderr, "Error from pthread_mutex_unlock: %s\n", strerror(err));
-            exit(1);
+    while (1) {
+        TaskInfo *myTask = lFindTask();
+        if (myTask == nullptr) {
+            //
+            // Nothing anywhere, sleep until a Launch wakes us up due to the
+            // arrival of more work.
+            //
+            uint32_t epoch = wakeEpoch.load();
+            ++workersSleeping;
+            myTask = lFindTask();
+            if (myTask == nullptr)
+                lWaitEpoch(epoch);
+            --workersSleeping;
+            if (myTask == nullptr)
+                continue;
         }
 
-        //
-        // And now actually run the task
-        //
-        DBG(fprintf(stderr, "running task %d from group %p\n", taskNumber, tg));
-        TaskInfo *myTask = tg->GetTaskInfo(taskNumber);
-        myTask->func(myTask->data, threadIndex, threadCount, myTask->taskIndex, myTask->taskCount(),
-                     myTask->taskIndex0(), myTask->taskIndex1(), myTask->taskIndex2(), myTask->taskCount0(),
-                     myTask->taskCount1(), myTask->taskCount2());
-
-        //
-        // Decrement the "number of unfinished tasks" counter in the task
-        // group.
-        //
-        lMemFence();
-        lAtomicAdd(&tg->numUnfinishedTasks, -1);
+        DBG(fprintf(stderr, "running task %d from group %p\n", myTask->taskIndex, myTask->group));
+        lRunTask(myTask);
     }
 
     pthread_exit(nullptr);
@@ -629,37 +1170,31 @@ static void InitTaskSystem() {
         while (1) {
             if (lAtomicCompareAndSwap32(&lock, 1, 0) == 0) {
                 if (threads == nullptr) {
-                    // We launch one fewer thread than there are cores,
-                    // since the main thread here will also grab jobs from
-                    // the task queue itself.
-                    nThreads = sysconf(_SC_NPROCESSORS_ONLN) - 1;
+                    // We launch one fewer thread than asked for, since
+                    // the main thread here will also grab jobs from the
+                    // task queue itself.
+                    lTaskSystemStarted = true;
+                    nThreads = lThreadCount() - 1;
+                    std::vector<int> order = lPlacement();
+                    nNodeDeques = lTileNodes() > 1 ? lTileNodes() : 0;
 
                     int err;
-                    if ((err = pthread_mutex_init(&taskSysMutex, nullptr)) != 0) {
+                    if ((err = pthread_mutex_init(&sharedDequeMutex, nullptr)) != 0 ||
+                        (err = pthread_mutex_init(&syncMutex, nullptr)) != 0) {
                         fprintf(stderr, "Error creating mutex: %s\n", strerror(err));
                         exit(1);
                     }
-
-                    constexpr std::size_t FILENAME_MAX_LEN{1024UL};
-                    char name[FILENAME_MAX_LEN];
-                    bool success = false;
-                    srand(time(nullptr));
-                    for (int i = 0; i < 10; i++) {
-                        // Some platforms (e.g. FreeBSD) require the name to begin with a slash
-                        snprintf(name, FILENAME_MAX_LEN, "/ispc_task.%d.%d", static_cast<int>(getpid()), static_cast<int>(rand()));
-                        workerSemaphore = sem_open(name, O_CREAT, S_IRUSR | S_IWUSR, 0);
-                        if (workerSemaphore != SEM_FAILED) {
-                            success = true;
-                            break;
-                        }
-                        fprintf(stderr, "Failed to create %s\n", name);
-                    }
-
-                    if (!success) {
-                        fprintf(stderr, "Error creating semaphore (%s): %s\n", name, strerror(errno));
+                    if ((err = pthread_cond_init(&syncCond, nullptr)) != 0) {
+                        fprintf(stderr, "Error creating condition variable: %s\n", strerror(err));
                         exit(1);
                     }
 
+                    deques = new WorkDeque[nThreads + 1 + nNodeDeques];
+                    nodeDequeMutex = new pthread_mutex_t[nNodeDeques];
+                    for (int k = 0; k < nNodeDeques; ++k)
+                        pthread_mutex_init(&nodeDequeMutex[k], nullptr);
+                    workerNode = new int[nThreads];
+
                     threads = (pthread_t *)malloc(nThreads * sizeof(pthread_t));
                     if (threads == nullptr) {
                         fprintf(stderr, "Error creating pthreads: %s\n", strerror(err));
@@ -667,14 +1202,24 @@ static void InitTaskSystem() {
                     }
 
                     for (int i = 0; i < nThreads; ++i) {
-                        err = pthread_create(&threads[i], nullptr, &lTaskEntry, (void *)((long long)i));
+                        pthread_attr_t attr;
+                        pthread_attr_init(&attr);
+                        if (nNodeDeques > 0 && order.empty()) {
+                            // NUMA without a placement: round robin over the
+                            // nodes, floating within the node
+                            workerNode[i] = (i + 1) % nNodeDeques;
+                            lPinThreadSet(&attr, lNumaTopology().cpus[workerNode[i]]);
+                        } else {
+                            workerNode[i] = order.empty() ? 0 : lNodeOfCPU(order[(i + 1) % order.size()]);
+                            lPinThread(&attr, order, i + 1);
+                        }
+                        err = pthread_create(&threads[i], &attr, &lTaskEntry, (void *)((long long)i));
+                        pthread_attr_destroy(&attr);
                         if (err != 0) {
                             fprintf(stderr, "Error creating pthread %d: %s\n", i, strerror(err));
                             exit(1);
                         }
                     }
-
-                    activeTaskGroups.reserve(64);
                 }
 
                 // Make sure all of the above goes to memory before we
@@ -689,142 +1234,79 @@ static void InitTaskSystem() {
 
 inline void TaskGroup::Launch(int baseCoord, int count) {
     //
-    // Acquire mutex, add task
+    // Count the tasks first, a thief may finish one before we're done
+    // pushing the rest.
     //
-    int err;
-    if ((err = pthread_mutex_lock(&taskSysMutex)) != 0) {
-        fprintf(stderr, "Error from pthread_mutex_lock: %s\n", strerror(err));
-        exit(1);
-    }
-
-    // Add the corresponding set of tasks to the waiting-to-be-run list for
-    // this task group.
-    //
-    // FIXME: it's a little ugly to hold a global mutex for this when we
-    // only need to make sure no one else is accessing this task group's
-    // waitingTasks list.  (But a small experiment in switching to a
-    // per-TaskGroup mutex showed worse performance!)
-    for (int i = 0; i < count; ++i)
-        waitingTasks.push_back(baseCoord + i);
-
-    // Add the task group to the global active list if it isn't there
-    // already.
-    if (inActiveList == false) {
-        activeTaskGroups.push_back(this);
-        inActiveList = true;
-    }
-
-    if ((err = pthread_mutex_unlock(&taskSysMutex)) != 0) {
-        fprintf(stderr, "Error from pthread_mutex_unlock: %s\n", strerror(err));
-        exit(1);
+    numUnfinishedTasks += count;
+
+    int self = lOwnDeque();
+    if (nNodeDeques > 0 && count > 0 && GetTaskInfo(baseCoord)->taskCount1() > 1) {
+        // Rows are in order, so the node only changes a few times
+        int locked = -1;
+        for (int i = 0; i < count; ++i) {
+            TaskInfo *ti = GetTaskInfo(baseCoord + i);
+            ti->group = this;
+            int node = ISPCNumaNodeOf(ti->taskIndex1(), ti->taskCount1());
+            if (node != locked) {
+                if (locked >= 0)
+                    pthread_mutex_unlock(&nodeDequeMutex[locked]);
+                pthread_mutex_lock(&nodeDequeMutex[node]);
+                locked = node;
+            }
+            deques[nThreads + 1 + node].Push(ti);
+        }
+        pthread_mutex_unlock(&nodeDequeMutex[locked]);
+    } else {
+        if (self == nThreads)
+            lLockSharedDeque();
+        for (int i = 0; i < count; ++i) {
+            TaskInfo *ti = GetTaskInfo(baseCoord + i);
+            ti->group = this;
+            deques[self].Push(ti);
+        }
+        if (self == nThreads)
+            lUnlockSharedDeque();
     }
 
     //
-    // Update the count of the number of tasks left to run in this task
-    // group.
-    //
-    lMemFence();
-    lAtomicAdd(&numUnfinishedTasks, count);
-
-    //
-    // Post to the worker semaphore to wake up worker threads that are
-    // sleeping waiting for tasks to show up
+    // Wake up worker threads that are sleeping waiting for tasks to show
+    // up, one futex call for all of them. A woken worker keeps stealing
+    // until everything is empty, so there's no point waking more than
+    // there are tasks. The fence orders the pushes before the look at
+    // workersSleeping.
     //
-    for (int i = 0; i < count; ++i)
-        if ((err = sem_post(workerSemaphore)) != 0) {
-            fprintf(stderr, "Error from sem_post: %s\n", strerror(err));
-            exit(1);
-        }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (workersSleeping.load() > 0)
+        lWakeWorkers(std::min(count, nThreads));
 }
 
 inline void TaskGroup::Sync() {
-    DBG(fprintf(stderr, "syncing %p - %d unfinished\n", tg, numUnfinishedTasks));
+    DBG(fprintf(stderr, "syncing %p - %d unfinished\n", this, numUnfinishedTasks.load()));
 
     while (numUnfinishedTasks > 0) {
         // All of the tasks in this group aren't finished yet.  We'll try
-        // to help out here since we don't have anything else to do...
-
-        DBG(fprintf(stderr, "while syncing %p - %d unfinished\n", tg, numUnfinishedTasks));
-
-        //
-        // Acquire the global task system mutex to grab a task to work on
-        //
-        int err;
-        if ((err = pthread_mutex_lock(&taskSysMutex)) != 0) {
-            fprintf(stderr, "Error from pthread_mutex_lock: %s\n", strerror(err));
-            exit(1);
-        }
-
-        TaskInfo *myTask = nullptr;
-        TaskGroup *runtg = this;
-        if (waitingTasks.size() > 0) {
-            int taskNumber = waitingTasks.back();
-            waitingTasks.pop_back();
-
-            if (waitingTasks.size() == 0) {
-                // There's nothing left to start running from this group,
-                // so remove it from the active task list.
-                activeTaskGroups.erase(std::find(activeTaskGroups.begin(), activeTaskGroups.end(), this));
-                inActiveList = false;
-            }
-            myTask = GetTaskInfo(taskNumber);
-            DBG(fprintf(stderr, "running task %d from group %p in sync\n", taskNumber, tg));
-        } else {
-            // Other threads are already working on all of the tasks in
-            // this group, so we can't help out by running one ourself.
-            // We'll try to run one from another group to make ourselves
-            // useful here.
-            if (activeTaskGroups.size() == 0) {
-                // No active task groups left--there's nothing for us to do.
-                if ((err = pthread_mutex_unlock(&taskSysMutex)) != 0) {
-                    fprintf(stderr, "Error from pthread_mutex_unlock: %s\n", strerror(err));
-                    exit(1);
-                }
-                // FIXME: We basically end up busy-waiting here, which is
-                // extra wasteful in a world with hyper-threading.  It would
-                // be much better to put this thread to sleep on a
-                // condition variable that was signaled when the last task
-                // in this group was finished.
-                usleep(1);
-                continue;
-            }
-
-            // Get a task to run from another task group.
-            runtg = activeTaskGroups.back();
-            assert(runtg->waitingTasks.size() > 0);
-
-            int taskNumber = runtg->waitingTasks.back();
-            runtg->waitingTasks.pop_back();
-            if (runtg->waitingTasks.size() == 0) {
-                // There's left to start running from this group, so remove
-                // it from the active task list.
-                activeTaskGroups.pop_back();
-                runtg->inActiveList = false;
-            }
-            myTask = runtg->GetTaskInfo(taskNumber);
-            DBG(fprintf(stderr, "running task %d from other group %p in sync\n", taskNumber, runtg));
-        }
-
-        if ((err = pthread_mutex_unlock(&taskSysMutex)) != 0) {
-            fprintf(stderr, "Error from pthread_mutex_unlock: %s\n", strerror(err));
-            exit(1);
+        // to help out here since we don't have anything else to do,
+        // starting with our own deque, which holds this group's tasks
+        // unless they got stolen.
+        TaskInfo *myTask = lFindTask();
+        if (myTask == nullptr) {
+            // Every task of this group has been taken and is running on
+            // another thread. Whatever those launch they sync on (and run)
+            // themselves, so we can go to sleep until the last one is done
+            // instead of competing with them for the core.
+            pthread_mutex_lock(&syncMutex);
+            ++syncSleepers;
+            while (numUnfinishedTasks > 0)
+                pthread_cond_wait(&syncCond, &syncMutex);
+            --syncSleepers;
+            pthread_mutex_unlock(&syncMutex);
+            break;
         }
 
-        //
-        // Do work for _myTask_
-        //
-        // FIXME: bogus values for thread index/thread count here as well..
-        myTask->func(myTask->data, 0, 1, myTask->taskIndex, myTask->taskCount(), myTask->taskIndex0(),
-                     myTask->taskIndex1(), myTask->taskIndex2(), myTask->taskCount0(), myTask->taskCount1(),
-                     myTask->taskCount2());
-
-        //
-        // Decrement the number of unfinished tasks counter
-        //
-        lMemFence();
-        lAtomicAdd(&runtg->numUnfinishedTasks, -1);
+        DBG(fprintf(stderr, "running task %d from group %p in sync\n", myTask->taskIndex, myTask->group));
+        lRunTask(myTask);
     }
-    DBG(fprintf(stderr, "sync for %p done!n", tg));
+    DBG(fprintf(stderr, "sync for %p done!n", this));
 }
 
 #endif // ISPC_USE_PTHREADS
@@ -1187,7 +1669,9 @@ void TaskSys::createThreads() {
     init();
     int reserved = 4;
     int minid = 2;
-    nThreads = sysconf(_SC_NPROCESSORS_ONLN) - reserved;
+    lTaskSystemStarted = true;
+    nThreads = lConfigThreads > 0 ? lConfigThreads - 1 : ISPCAvailableCPUs() - reserved;
+    std::vector<int> order = lPlacement();
 
     thread = (pthread_t *)malloc(nThreads * sizeof(pthread_t));
 
@@ -1197,11 +1681,14 @@ void TaskSys::createThreads() {
         pthread_attr_init(&attr);
         pthread_attr_setstacksize(&attr, 2 * 1024 * 1024);
 
-        int threadID = minid + i;
-        cpu_set_t cpuset;
-        CPU_ZERO(&cpuset);
-        CPU_SET(threadID, &cpuset);
-        int ret = pthread_attr_setaffinity_np(&attr, sizeof(cpuset), &cpuset);
+        if (order.empty()) {
+            int threadID = minid + i;
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            CPU_SET(threadID, &cpuset);
+            pthread_attr_setaffinity_np(&attr, sizeof(cpuset), &cpuset);
+        } else
+            lPinThread(&attr, order, i + 1);
 
         int err = pthread_create(&thread[i], &attr, &_threadFct, this);
         ++numThreadsRunning;
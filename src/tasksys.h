@@ -0,0 +1,58 @@
+/*
+  Copyright (c) 2011-2025, Intel Corporation
+
+  SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/*
+  Thread count and placement for the pthreads task systems in tasksys.cpp
+  (ISPC_USE_PTHREADS, ISPC_USE_PTHREADS_FULLY_SUBSCRIBED). The other task
+  systems leave threading to their runtime and ignore this. The settings are
+  read when the first task is launched, later calls change nothing.
+*/
+
+#ifndef ISPC_TASKSYS_H
+#define ISPC_TASKSYS_H
+
+#include <stddef.h>
+
+enum ISPCAffinity {
+    ISPC_AFFINITY_NONE,    // threads float, placement is up to the OS
+    ISPC_AFFINITY_COMPACT, // fill the hyperthreads of a core, then the next core, then the next socket
+    ISPC_AFFINITY_SCATTER, // one thread per socket, then per core, the second hyperthreads last
+    ISPC_AFFINITY_LIST,    // the given CPUs in order, wrapping around
+};
+
+extern "C" {
+// threads counts the thread that calls into ispc, which runs tasks while it
+// syncs; threads <= 0 takes ISPCAvailableCPUs(). Worker i is pinned to the
+// (i+1)-th CPU of the placement order, the first one is left for the caller.
+// cpus/cpuCount are only read for ISPC_AFFINITY_LIST. Returns false when the
+// task system is already running or the list is empty.
+bool ISPCSetTaskSystem(int threads, ISPCAffinity affinity, const int *cpus, int cpuCount);
+
+// CPUs this process can actually use: its affinity mask (cpusets, taskset),
+// capped by a cgroup CPU quota rounded up. At least 1.
+int ISPCAvailableCPUs();
+
+// NUMA tiles: workers go round robin over the NUMA nodes (or to the node of
+// their CPU with an affinity) and each 2D launch hands the band of rows
+// ISPCNumaNodeOf(taskIndex1, taskCount1) to that node's workers first.
+// Returns false when the task system is already running.
+bool ISPCSetNuma(bool on);
+
+// NUMA nodes with CPUs we can use, numbered 0..n-1. At least 1.
+int ISPCNumaNodes();
+
+// Node that gets row index of count rows of tasks, 0 while NUMA tiles are off
+int ISPCNumaNodeOf(int index, int count);
+
+// Prefer node for the not yet touched pages of [addr, addr + bytes)
+bool ISPCNumaBind(void *addr, size_t bytes, int node);
+
+// GB/s read plus written by every CPU of cpuNode streaming through bytes
+// on memNode, 0 if that can't be measured
+double ISPCNumaBandwidth(int cpuNode, int memNode, size_t bytes);
+}
+
+#endif // ISPC_TASKSYS_H